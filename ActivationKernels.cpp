@@ -0,0 +1,288 @@
+#include "ActivationKernels.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NEAT_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // Noyaux scalaires : servent de repli et traitent la fin des tableaux vectorisés
+    void sigmoid_scalar(double *values, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = Sigmoid{}(values[i]);
+        }
+    }
+
+    void tanh_scalar(double *values, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = Tanh{}(values[i]);
+        }
+    }
+
+    void relu_scalar(double *values, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++)
+        {
+            values[i] = ReLU{}(values[i]);
+        }
+    }
+
+#ifdef NEAT_X86_KERNELS
+
+    // Constantes de l'approximation rationnelle de exp et tanh (Cephes)
+    constexpr double kExpHi = 709.0;
+    constexpr double kExpLo = -708.0;
+    constexpr double kLog2e = 1.4426950408889634073599;
+    constexpr double kExpC1 = 6.93145751953125E-1;
+    constexpr double kExpC2 = 1.42860682030941723212E-6;
+    constexpr double kExpP0 = 1.26177193074810590878E-4;
+    constexpr double kExpP1 = 3.02994407707441961300E-2;
+    constexpr double kExpP2 = 9.99999999999999999910E-1;
+    constexpr double kExpQ0 = 3.00198505138664455042E-6;
+    constexpr double kExpQ1 = 2.52448340349684104192E-3;
+    constexpr double kExpQ2 = 2.27265548208155028766E-1;
+    constexpr double kExpQ3 = 2.00000000000000000009E0;
+    constexpr double kTanhSmall = 0.625;
+    constexpr double kTanhP0 = -9.64399179425052238628E-1;
+    constexpr double kTanhP1 = -9.92877231001918586564E1;
+    constexpr double kTanhP2 = -1.61468768441708447952E3;
+    constexpr double kTanhQ0 = 1.12811678491632931402E2;
+    constexpr double kTanhQ1 = 2.23548839060100448583E3;
+    constexpr double kTanhQ2 = 4.84406305325125486048E3;
+
+    // --- SSE2 : 2 doubles par registre ---
+
+    __attribute__((target("sse2"))) inline __m128d exp_sse2(__m128d x)
+    {
+        // min/max rendent une borne pour NaN : ces voies sont remises à NaN en fin de calcul, comme std::exp
+        const __m128d nan = _mm_cmpunord_pd(x, x);
+        const __m128d input = x;
+        x = _mm_min_pd(_mm_max_pd(x, _mm_set1_pd(kExpLo)), _mm_set1_pd(kExpHi));
+
+        __m128i n = _mm_cvtpd_epi32(_mm_mul_pd(x, _mm_set1_pd(kLog2e))); // Arrondi au plus proche
+        __m128d nd = _mm_cvtepi32_pd(n);
+        __m128d r = _mm_sub_pd(_mm_sub_pd(x, _mm_mul_pd(nd, _mm_set1_pd(kExpC1))), _mm_mul_pd(nd, _mm_set1_pd(kExpC2)));
+
+        __m128d rr = _mm_mul_pd(r, r);
+        __m128d px = _mm_add_pd(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(kExpP0), rr), _mm_set1_pd(kExpP1)), rr), _mm_set1_pd(kExpP2));
+        px = _mm_mul_pd(px, r);
+        __m128d qx = _mm_add_pd(_mm_mul_pd(_mm_set1_pd(kExpQ0), rr), _mm_set1_pd(kExpQ1));
+        qx = _mm_add_pd(_mm_mul_pd(qx, rr), _mm_set1_pd(kExpQ2));
+        qx = _mm_add_pd(_mm_mul_pd(qx, rr), _mm_set1_pd(kExpQ3));
+        __m128d e = _mm_div_pd(px, _mm_sub_pd(qx, px));
+        e = _mm_add_pd(_mm_set1_pd(1.0), _mm_add_pd(e, e));
+
+        // 2^n construit directement dans l'exposant IEEE 754 (n + 1023 est toujours positif ici)
+        __m128i biased = _mm_add_epi32(n, _mm_set1_epi32(1023));
+        __m128i pow2 = _mm_slli_epi64(_mm_unpacklo_epi32(biased, _mm_setzero_si128()), 52);
+        __m128d result = _mm_mul_pd(e, _mm_castsi128_pd(pow2));
+        return _mm_or_pd(_mm_and_pd(nan, input), _mm_andnot_pd(nan, result));
+    }
+
+    __attribute__((target("sse2"))) inline __m128d tanh_sse2(__m128d x)
+    {
+        const __m128d sign_mask = _mm_set1_pd(-0.0);
+        __m128d sign = _mm_and_pd(x, sign_mask);
+        __m128d ax = _mm_andnot_pd(sign_mask, x);
+
+        // |x| < 0.625 : approximation rationnelle, sans annulation près de 0
+        __m128d z = _mm_mul_pd(x, x);
+        __m128d p = _mm_add_pd(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_set1_pd(kTanhP0), z), _mm_set1_pd(kTanhP1)), z), _mm_set1_pd(kTanhP2));
+        __m128d q = _mm_add_pd(_mm_mul_pd(_mm_add_pd(_mm_mul_pd(_mm_add_pd(z, _mm_set1_pd(kTanhQ0)), z), _mm_set1_pd(kTanhQ1)), z), _mm_set1_pd(kTanhQ2));
+        __m128d small = _mm_add_pd(x, _mm_mul_pd(_mm_mul_pd(x, z), _mm_div_pd(p, q)));
+
+        // Sinon : tanh(|x|) = 1 - 2 / (exp(2|x|) + 1)
+        __m128d s = exp_sse2(_mm_add_pd(ax, ax));
+        __m128d large = _mm_sub_pd(_mm_set1_pd(1.0), _mm_div_pd(_mm_set1_pd(2.0), _mm_add_pd(s, _mm_set1_pd(1.0))));
+        large = _mm_or_pd(large, sign);
+
+        __m128d use_small = _mm_cmplt_pd(ax, _mm_set1_pd(kTanhSmall));
+        return _mm_or_pd(_mm_and_pd(use_small, small), _mm_andnot_pd(use_small, large));
+    }
+
+    __attribute__((target("sse2"))) void sigmoid_sse2(double *values, std::size_t n)
+    {
+        const __m128d one = _mm_set1_pd(1.0);
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            __m128d x = _mm_loadu_pd(values + i);
+            __m128d e = exp_sse2(_mm_sub_pd(_mm_setzero_pd(), x));
+            _mm_storeu_pd(values + i, _mm_div_pd(one, _mm_add_pd(one, e)));
+        }
+        sigmoid_scalar(values + i, n - i);
+    }
+
+    __attribute__((target("sse2"))) void tanh_sse2_array(double *values, std::size_t n)
+    {
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(values + i, tanh_sse2(_mm_loadu_pd(values + i)));
+        }
+        tanh_scalar(values + i, n - i);
+    }
+
+    __attribute__((target("sse2"))) void relu_sse2(double *values, std::size_t n)
+    {
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2)
+        {
+            _mm_storeu_pd(values + i, _mm_max_pd(_mm_loadu_pd(values + i), _mm_setzero_pd()));
+        }
+        relu_scalar(values + i, n - i);
+    }
+
+    // --- AVX2 : 4 doubles par registre ---
+
+    __attribute__((target("avx2"))) inline __m256d exp_avx2(__m256d x)
+    {
+        const __m256d nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+        const __m256d input = x;
+        x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(kExpLo)), _mm256_set1_pd(kExpHi));
+
+        __m128i n = _mm256_cvtpd_epi32(_mm256_mul_pd(x, _mm256_set1_pd(kLog2e))); // Arrondi au plus proche
+        __m256d nd = _mm256_cvtepi32_pd(n);
+        __m256d r = _mm256_sub_pd(_mm256_sub_pd(x, _mm256_mul_pd(nd, _mm256_set1_pd(kExpC1))), _mm256_mul_pd(nd, _mm256_set1_pd(kExpC2)));
+
+        __m256d rr = _mm256_mul_pd(r, r);
+        __m256d px = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(kExpP0), rr), _mm256_set1_pd(kExpP1)), rr), _mm256_set1_pd(kExpP2));
+        px = _mm256_mul_pd(px, r);
+        __m256d qx = _mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(kExpQ0), rr), _mm256_set1_pd(kExpQ1));
+        qx = _mm256_add_pd(_mm256_mul_pd(qx, rr), _mm256_set1_pd(kExpQ2));
+        qx = _mm256_add_pd(_mm256_mul_pd(qx, rr), _mm256_set1_pd(kExpQ3));
+        __m256d e = _mm256_div_pd(px, _mm256_sub_pd(qx, px));
+        e = _mm256_add_pd(_mm256_set1_pd(1.0), _mm256_add_pd(e, e));
+
+        __m256i biased = _mm256_cvtepi32_epi64(_mm_add_epi32(n, _mm_set1_epi32(1023)));
+        __m256i pow2 = _mm256_slli_epi64(biased, 52);
+        return _mm256_blendv_pd(_mm256_mul_pd(e, _mm256_castsi256_pd(pow2)), input, nan);
+    }
+
+    __attribute__((target("avx2"))) inline __m256d tanh_avx2(__m256d x)
+    {
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        __m256d sign = _mm256_and_pd(x, sign_mask);
+        __m256d ax = _mm256_andnot_pd(sign_mask, x);
+
+        __m256d z = _mm256_mul_pd(x, x);
+        __m256d p = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_set1_pd(kTanhP0), z), _mm256_set1_pd(kTanhP1)), z), _mm256_set1_pd(kTanhP2));
+        __m256d q = _mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_add_pd(z, _mm256_set1_pd(kTanhQ0)), z), _mm256_set1_pd(kTanhQ1)), z), _mm256_set1_pd(kTanhQ2));
+        __m256d small = _mm256_add_pd(x, _mm256_mul_pd(_mm256_mul_pd(x, z), _mm256_div_pd(p, q)));
+
+        __m256d s = exp_avx2(_mm256_add_pd(ax, ax));
+        __m256d large = _mm256_sub_pd(_mm256_set1_pd(1.0), _mm256_div_pd(_mm256_set1_pd(2.0), _mm256_add_pd(s, _mm256_set1_pd(1.0))));
+        large = _mm256_or_pd(large, sign);
+
+        __m256d use_small = _mm256_cmp_pd(ax, _mm256_set1_pd(kTanhSmall), _CMP_LT_OQ);
+        return _mm256_blendv_pd(large, small, use_small);
+    }
+
+    __attribute__((target("avx2"))) void sigmoid_avx2(double *values, std::size_t n)
+    {
+        const __m256d one = _mm256_set1_pd(1.0);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256d x = _mm256_loadu_pd(values + i);
+            __m256d e = exp_avx2(_mm256_sub_pd(_mm256_setzero_pd(), x));
+            _mm256_storeu_pd(values + i, _mm256_div_pd(one, _mm256_add_pd(one, e)));
+        }
+        sigmoid_scalar(values + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) void tanh_avx2_array(double *values, std::size_t n)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(values + i, tanh_avx2(_mm256_loadu_pd(values + i)));
+        }
+        tanh_scalar(values + i, n - i);
+    }
+
+    __attribute__((target("avx2"))) void relu_avx2(double *values, std::size_t n)
+    {
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            _mm256_storeu_pd(values + i, _mm256_max_pd(_mm256_loadu_pd(values + i), _mm256_setzero_pd()));
+        }
+        relu_scalar(values + i, n - i);
+    }
+
+#endif // NEAT_X86_KERNELS
+
+    struct KernelTable
+    {
+        void (*sigmoid)(double *, std::size_t);
+        void (*tanh)(double *, std::size_t);
+        void (*relu)(double *, std::size_t);
+        const char *isa;
+    };
+
+    KernelTable select_kernels()
+    {
+#ifdef NEAT_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return KernelTable{sigmoid_avx2, tanh_avx2_array, relu_avx2, "avx2"};
+        }
+        if (__builtin_cpu_supports("sse2"))
+        {
+            return KernelTable{sigmoid_sse2, tanh_sse2_array, relu_sse2, "sse2"};
+        }
+#endif
+        return KernelTable{sigmoid_scalar, tanh_scalar, relu_scalar, "scalar"};
+    }
+
+    // Sélection faite une seule fois, au premier appel
+    const KernelTable &kernels()
+    {
+        static const KernelTable table = select_kernels();
+        return table;
+    }
+
+    struct ArrayActivation
+    {
+        double *values;
+        std::size_t n;
+
+        void operator()(const Sigmoid &) const { kernels().sigmoid(values, n); }
+        void operator()(const Tanh &) const { kernels().tanh(values, n); }
+        void operator()(const ReLU &) const { kernels().relu(values, n); }
+    };
+} // namespace
+
+void sigmoid_array(double *values, std::size_t n)
+{
+    kernels().sigmoid(values, n);
+}
+
+void tanh_array(double *values, std::size_t n)
+{
+    kernels().tanh(values, n);
+}
+
+void relu_array(double *values, std::size_t n)
+{
+    kernels().relu(values, n);
+}
+
+void apply_activation(const ActivationFn &activation, double *values, std::size_t n)
+{
+    std::visit(ArrayActivation{values, n}, activation);
+}
+
+const char *activation_kernels_isa()
+{
+    return kernels().isa;
+}
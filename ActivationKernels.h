@@ -0,0 +1,50 @@
+#ifndef ACTIVATION_KERNELS_H
+#define ACTIVATION_KERNELS_H
+
+#include <cstddef>
+#include "ActivationFn.h"
+
+/**
+ * @brief Applique la sigmoïde, en place, à un tableau de pré-activations.
+ *
+ * L'implémentation (AVX2, SSE2 ou scalaire) est choisie une seule fois à l'exécution
+ * selon les instructions supportées par le processeur (CPUID).
+ *
+ * @param values Le tableau de valeurs à transformer.
+ * @param n Le nombre de valeurs.
+ */
+void sigmoid_array(double *values, std::size_t n);
+
+/**
+ * @brief Applique la tangente hyperbolique, en place, à un tableau de pré-activations.
+ *
+ * @param values Le tableau de valeurs à transformer.
+ * @param n Le nombre de valeurs.
+ */
+void tanh_array(double *values, std::size_t n);
+
+/**
+ * @brief Applique ReLU, en place, à un tableau de pré-activations.
+ *
+ * @param values Le tableau de valeurs à transformer.
+ * @param n Le nombre de valeurs.
+ */
+void relu_array(double *values, std::size_t n);
+
+/**
+ * @brief Applique la fonction d'activation du variant à un tableau de valeurs.
+ *
+ * Le variant n'est résolu qu'une seule fois pour tout le tableau.
+ *
+ * @param activation La fonction d'activation à appliquer.
+ * @param values Le tableau de valeurs à transformer.
+ * @param n Le nombre de valeurs.
+ */
+void apply_activation(const ActivationFn &activation, double *values, std::size_t n);
+
+/**
+ * @brief Retourne le nom du jeu d'instructions utilisé par les noyaux ("avx2", "sse2" ou "scalar").
+ */
+const char *activation_kernels_isa();
+
+#endif // ACTIVATION_KERNELS_H
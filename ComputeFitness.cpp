@@ -6,8 +6,8 @@
 #include <algorithm> // Pour std::max_element
 
 
-// Constructeur qui initialise la référence RNG
-ComputeFitness::ComputeFitness(RNG &rng) : rng(rng) {}
+// Constructeur qui dérive un flux aléatoire indépendant
+ComputeFitness::ComputeFitness(RNG &rng) : rng(rng.split()) {}
 
 // Surcharge de l'opérateur () pour évaluer la fitness d'un génome
 double ComputeFitness::operator()(const Genome &genome, int ant_id) const {
@@ -49,28 +49,38 @@ double ComputeFitness::evaluate(const Genome &genome, int ant_id) const {
     return 0;
 }
 
-double ComputeFitness::evaluate_rpc(const Genome &genome, int ant_id) const {
-    FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(genome);
-
-    int wins = 0;
-    int rounds = 10;
+namespace {
+    const int rpc_rounds = 10;
 
     // Stratégie fixe de l'adversaire : alterner entre "Papier", "Ciseaux", et "Pierre"
-    int opponent_moves[] = {1, 1, 1};
-    
+    const int rpc_opponent_moves[] = {1, 1, 1};
+}
 
-    for (int round = 0; round < rounds; ++round) {
-        int opponent_move = opponent_moves[round % 3];  // Alternance fixe
+double ComputeFitness::evaluate_rpc(const Genome &genome, int ant_id) const {
+    FeedForwardNeuralNetwork &network = network_cache.get(genome);
 
-        //Affichage le mouvement de l'adversaire
-        //std::cout << "Opponent move: " << opponent_move << std::endl;
+    // Tous les rounds sont évalués en un seul passage sur le réseau
+    std::vector<double> outputs = network.activate_batch(rpc_inputs(), rpc_rounds);
+    return score_rpc(outputs.data(), rpc_rounds, network.num_outputs());
+}
 
-        // Obtenir l'action du réseau neuronal
-        std::vector<double> inputs = { double(opponent_move) };
-        std::vector<double> outputs = network.activate(inputs);
+std::vector<double> ComputeFitness::rpc_inputs() {
+    std::vector<double> inputs(rpc_rounds);
+    for (int round = 0; round < rpc_rounds; ++round) {
+        inputs[round] = double(rpc_opponent_moves[round % 3]);  // Alternance fixe
+    }
+    return inputs;
+}
+
+double ComputeFitness::score_rpc(const double *outputs, std::size_t num_rounds, std::size_t num_outputs) {
+    int wins = 0;
+
+    for (std::size_t round = 0; round < num_rounds; ++round) {
+        int opponent_move = rpc_opponent_moves[round % 3];
 
         // Décoder l'action
-        int player_move = std::distance(outputs.begin(), std::max_element(outputs.begin(), outputs.end()));
+        const double *round_begin = outputs + round * num_outputs;
+        int player_move = std::distance(round_begin, std::max_element(round_begin, round_begin + num_outputs));
 
         // Calculer le résultat
         int result = (3 + player_move - opponent_move) % 3 - 1;
@@ -78,7 +88,14 @@ double ComputeFitness::evaluate_rpc(const Genome &genome, int ant_id) const {
         if (result == 1) wins++;
     }
 
-    return static_cast<double>(wins) / rounds;
+    return static_cast<double>(wins) / num_rounds;
 }
 
+NetworkCache &ComputeFitness::get_network_cache() const {
+    return network_cache;
+}
+
+GroupedEvaluator ComputeFitness::make_rpc_evaluator() const {
+    return GroupedEvaluator(rpc_inputs(), rpc_rounds, &ComputeFitness::score_rpc);
+}
 
@@ -3,10 +3,13 @@
 
     #include "RNG.h"  // Inclure la classe RNG (générateur de nombres aléatoires)
     #include "Genome.h"  // Inclure la définition du Genome
+    #include "GroupedEvaluator.h"
+    #include "NetworkCache.h"
 
     class ComputeFitness {
     public:
-        // Constructeur qui prend un générateur RNG en référence
+        // Constructeur : l'instance dérive son propre flux aléatoire de `rng` (voir RNG::split),
+        // de sorte que plusieurs instances peuvent être utilisées en parallèle
         ComputeFitness(RNG &rng);
 
         // Surcharge de l'opérateur () pour évaluer la fitness d'un génome
@@ -16,10 +19,23 @@
         double evaluate(const Genome &genome, int ant_id) const;
 
         double evaluate_rpc(const Genome &genome, int ant_id) const;
+
+        // Entrées des rounds de pierre-papier-ciseaux (une ligne par round)
+        static std::vector<double> rpc_inputs();
+
+        // Score pierre-papier-ciseaux à partir des sorties du réseau (une ligne par round)
+        static double score_rpc(const double *outputs, std::size_t num_rounds, std::size_t num_outputs);
+
+        // Évaluateur qui calcule evaluate_rpc pour toute une population en regroupant les topologies identiques
+        GroupedEvaluator make_rpc_evaluator() const;
+
+        // Cache des réseaux compilés, partagé par evaluate_rpc et les boucles de simulation
+        NetworkCache &get_network_cache() const;
         
 
     private:
-        RNG &rng;  // Référence au générateur RNG utilisé pour l'évaluation
+        mutable RNG rng;  // Flux aléatoire propre à cette instance
+        mutable NetworkCache network_cache;  // Réseaux compilés par génome et version
     };
 
     #endif // COMPUTEFITNESS_H
@@ -0,0 +1,88 @@
+#include "FitnessCache.h"
+
+FitnessCache::FitnessCache(std::size_t capacity) : m_capacity(capacity)
+{
+    m_index.reserve(capacity);
+}
+
+bool FitnessCache::lookup(std::uint64_t key, double &fitness)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        return false;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    fitness = it->second->second;
+    return true;
+}
+
+void FitnessCache::store(std::uint64_t key, double fitness)
+{
+    if (m_capacity == 0)
+    {
+        return;
+    }
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        it->second->second = fitness;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return;
+    }
+
+    if (m_entries.size() >= m_capacity)
+    {
+        m_index.erase(m_entries.back().first);
+        m_entries.pop_back();
+        ++m_stats.evictions;
+    }
+    m_entries.emplace_front(key, fitness);
+    m_index.emplace(key, m_entries.begin());
+}
+
+void FitnessCache::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+}
+
+std::size_t FitnessCache::size() const
+{
+    return m_entries.size();
+}
+
+std::size_t FitnessCache::capacity() const
+{
+    return m_capacity;
+}
+
+FitnessCache::Stats &FitnessCache::get_stats()
+{
+    return m_stats;
+}
+
+const FitnessCache::Stats &FitnessCache::get_stats() const
+{
+    return m_stats;
+}
+
+void FitnessCache::reset_stats()
+{
+    m_stats = Stats{};
+}
+
+double FitnessCache::Stats::hit_rate() const
+{
+    std::size_t lookups = hits + evaluated;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+void FitnessCache::Stats::print(std::ostream &out) const
+{
+    out << "Mémoïsation des fitness : " << reused << " conservées, "
+        << hits << " trouvées dans la table, "
+        << evaluated << " calculées (taux de succès " << hit_rate() * 100.0 << " %, "
+        << evictions << " évincées)" << std::endl;
+}
@@ -0,0 +1,79 @@
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Table de transposition des fitness, indexée par empreinte de contenu de génome.
+ *
+ * Deux génomes identiques produits par des parents différents (ou un clone qui n'a subi aucune
+ * mutation) ont la même empreinte (`Genome::content_hash`) : leur fitness n'est calculée qu'une fois,
+ * y compris d'une génération à l'autre. La table est bornée : au-delà de sa capacité, l'entrée
+ * la moins récemment utilisée est évincée.
+ *
+ * La table n'est pas protégée par un verrou : Population la consulte et la remplit en série,
+ * avant et après l'évaluation parallèle.
+ */
+class FitnessCache
+{
+public:
+    // Statistiques d'une évaluation (remises à zéro à chaque génération)
+    struct Stats
+    {
+        std::size_t reused = 0;    // Individus dont la fitness était déjà calculée (élites)
+        std::size_t hits = 0;      // Fitness trouvées dans la table
+        std::size_t evaluated = 0; // Fitness calculées
+        std::size_t evictions = 0; // Entrées évincées pour respecter la capacité
+
+        double hit_rate() const;
+        void print(std::ostream &out) const;
+    };
+
+    /**
+     * @brief Construit une table de transposition.
+     *
+     * @param capacity Le nombre maximal d'entrées ; 0 désactive la table.
+     */
+    explicit FitnessCache(std::size_t capacity = 0);
+
+    /**
+     * @brief Cherche la fitness d'un génome et la marque comme récemment utilisée.
+     *
+     * @param key L'empreinte de contenu du génome.
+     * @param fitness Reçoit la fitness si elle est connue.
+     * @return true Si la fitness est dans la table.
+     */
+    bool lookup(std::uint64_t key, double &fitness);
+
+    /**
+     * @brief Enregistre la fitness d'un génome, en évinçant l'entrée la plus ancienne si la table est pleine.
+     *
+     * @param key L'empreinte de contenu du génome.
+     * @param fitness La fitness calculée.
+     */
+    void store(std::uint64_t key, double fitness);
+
+    void clear();
+
+    std::size_t size() const;
+    std::size_t capacity() const;
+
+    Stats &get_stats();
+    const Stats &get_stats() const;
+    void reset_stats();
+
+private:
+    using Entry = std::pair<std::uint64_t, double>;
+
+    std::size_t m_capacity;
+    std::list<Entry> m_entries; // De la plus récemment utilisée à la plus ancienne
+    std::unordered_map<std::uint64_t, std::list<Entry>::iterator> m_index;
+    Stats m_stats;
+};
+
+#endif // FITNESS_CACHE_H
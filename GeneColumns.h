@@ -0,0 +1,439 @@
+#ifndef GENE_COLUMNS_H
+#define GENE_COLUMNS_H
+
+#include "neat.h"
+#include "Activation.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * Disposition et codage des gènes d'un Genome, choisis à la compilation.
+ *
+ * Par défaut, les gènes sont rangés en tableau de structures (un std::pmr::vector de LinkGene ou de
+ * NeuronGene). Avec NEAT_SOA_GENOMES défini (par exemple -DNEAT_SOA_GENOMES dans CXXFLAGS), ils sont
+ * rangés en structure de tableaux (LinkColumns, NeuronColumns) : un tableau contigu par champ, les
+ * états d'activation des liens dans un vecteur de bits. Les parcours qui ne lisent qu'un champ (clés
+ * d'innovation et poids pour la distance de compatibilité, par exemple) ne chargent alors que ce champ.
+ *
+ * Avec NEAT_COMPACT_GENES défini, les colonnes utilisent un codage compact (voir CompactEncoding) :
+ * poids et biais en float, identifiants des deux neurones d'un lien dans un seul mot de 32 bits. Les
+ * identifiants de neurones sont alors limités à `max_neuron_id` (65535), vérifié par InnovationTracker.
+ * -DNEAT_COMPACT_GENES=16 range en plus les poids et biais en virgule fixe sur 16 bits (voir
+ * Fixed16Encoding). Les valeurs sont arrondies à l'écriture ; la lecture et l'évaluation restent en double.
+ *
+ * Toutes les dispositions offrent la même interface de lecture : size, empty, operator[], back, at et
+ * itération, qui rendent des gènes par valeur pour les colonnes. Les modifications passent par les
+ * fonctions `set_link_weight`, `set_link_enabled`, `set_neuron_bias` et `erase_genes_if`, qui n'écrivent
+ * que le champ concerné, ou par push_back, insert et erase.
+ */
+namespace neat
+{
+    // Valeurs réelles (poids, biais) stockées en double
+    struct DoubleValues
+    {
+        using Stored = double;
+        static Stored encode(double value) { return value; }
+        static double decode(Stored value) { return value; }
+    };
+
+    // Valeurs réelles stockées en float
+    struct FloatValues
+    {
+        using Stored = float;
+        static Stored encode(double value) { return static_cast<float>(value); }
+        static double decode(Stored value) { return value; }
+    };
+
+    // Valeurs réelles en virgule fixe sur 16 bits : pas de 1/1024, plage [-32, 32) qui couvre DoubleConfig
+    struct Fixed16Values
+    {
+        using Stored = std::int16_t;
+        static constexpr double scale = 1024.0;
+
+        static Stored encode(double value)
+        {
+            // std::clamp laisse passer NaN, dont la conversion en entier est indéfinie : NaN est codé par 0
+            if (std::isnan(value))
+            {
+                return 0;
+            }
+            const double scaled = std::round(value * scale);
+            return static_cast<Stored>(std::clamp(scaled, -32768.0, 32767.0));
+        }
+        static double decode(Stored value) { return value / scale; }
+    };
+
+    /**
+     * @brief Codage des gènes en colonnes : type des valeurs réelles et mot qui range les deux
+     * identifiants de neurones d'un lien (la moitié des bits pour chacun).
+     */
+    template <typename Values, typename LinkIdWord>
+    struct GeneEncoding
+    {
+        using Value = typename Values::Stored;
+        using LinkWord = LinkIdWord;
+
+        static constexpr int id_bits = 4 * sizeof(LinkIdWord);
+
+        static Value encode_value(double value) { return Values::encode(value); }
+        static double decode_value(Value value) { return Values::decode(value); }
+
+        static LinkWord pack(const LinkId &link_id)
+        {
+            constexpr std::uint64_t max_id = (std::uint64_t(1) << id_bits) - 1;
+            if (link_id.input_id < 0 || link_id.output_id < 0 ||
+                static_cast<std::uint64_t>(link_id.input_id) > max_id ||
+                static_cast<std::uint64_t>(link_id.output_id) > max_id)
+            {
+                throw std::runtime_error("GeneEncoding: identifiant de neurone hors de la plage du codage des liens.");
+            }
+            return static_cast<LinkWord>((static_cast<LinkWord>(link_id.input_id) << id_bits) |
+                                         static_cast<LinkWord>(link_id.output_id));
+        }
+
+        static LinkId unpack(LinkWord word)
+        {
+            constexpr LinkWord mask = static_cast<LinkWord>((std::uint64_t(1) << id_bits) - 1);
+            return LinkId{static_cast<int>(word >> id_bits), static_cast<int>(word & mask)};
+        }
+    };
+
+    using WideEncoding = GeneEncoding<DoubleValues, std::uint64_t>;    // Valeurs exactes
+    using CompactEncoding = GeneEncoding<FloatValues, std::uint32_t>;  // Identifiants < 65536
+    using Fixed16Encoding = GeneEncoding<Fixed16Values, std::uint32_t>;
+
+    /**
+     * @brief Itérateur en lecture sur des colonnes de gènes ; le déréférencement reconstruit le gène.
+     */
+    template <typename Columns>
+    class ColumnIterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = typename Columns::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        // Le gène reconstruit, pour `it->champ`
+        struct pointer
+        {
+            value_type gene;
+            const value_type *operator->() const { return &gene; }
+        };
+
+        ColumnIterator() = default;
+        ColumnIterator(const Columns *columns, std::size_t index) : columns(columns), index(index) {}
+
+        reference operator*() const { return (*columns)[index]; }
+        pointer operator->() const { return pointer{(*columns)[index]}; }
+        reference operator[](difference_type n) const { return (*columns)[index + n]; }
+
+        ColumnIterator &operator++() { ++index; return *this; }
+        ColumnIterator operator++(int) { ColumnIterator old = *this; ++index; return old; }
+        ColumnIterator &operator--() { --index; return *this; }
+        ColumnIterator operator--(int) { ColumnIterator old = *this; --index; return old; }
+        ColumnIterator &operator+=(difference_type n) { index += n; return *this; }
+        ColumnIterator &operator-=(difference_type n) { index -= n; return *this; }
+        ColumnIterator operator+(difference_type n) const { return ColumnIterator(columns, index + n); }
+        ColumnIterator operator-(difference_type n) const { return ColumnIterator(columns, index - n); }
+        friend ColumnIterator operator+(difference_type n, const ColumnIterator &it) { return it + n; }
+        difference_type operator-(const ColumnIterator &other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+
+        bool operator==(const ColumnIterator &other) const { return index == other.index; }
+        bool operator!=(const ColumnIterator &other) const { return index != other.index; }
+        bool operator<(const ColumnIterator &other) const { return index < other.index; }
+        bool operator>(const ColumnIterator &other) const { return index > other.index; }
+        bool operator<=(const ColumnIterator &other) const { return index <= other.index; }
+        bool operator>=(const ColumnIterator &other) const { return index >= other.index; }
+
+        std::size_t position() const { return index; }
+
+    private:
+        const Columns *columns = nullptr;
+        std::size_t index = 0;
+    };
+
+    /**
+     * @brief Liens d'un génome en structure de tableaux.
+     */
+    template <typename Encoding>
+    class BasicLinkColumns
+    {
+    public:
+        using value_type = LinkGene;
+        using const_iterator = ColumnIterator<BasicLinkColumns>;
+        using iterator = const_iterator;
+
+        BasicLinkColumns() = default;
+        BasicLinkColumns(std::pmr::memory_resource *resource)
+            : link_ids(resource), weights(resource), innovations(resource), enabled(resource) {}
+
+        std::size_t size() const { return innovations.size(); }
+        bool empty() const { return innovations.empty(); }
+
+        void reserve(std::size_t n)
+        {
+            link_ids.reserve(n);
+            weights.reserve(n);
+            innovations.reserve(n);
+            enabled.reserve(n);
+        }
+
+        LinkGene operator[](std::size_t i) const
+        {
+            return LinkGene{Encoding::unpack(link_ids[i]), weight(i), enabled[i], innovations[i]};
+        }
+
+        LinkGene at(std::size_t i) const
+        {
+            if (i >= size())
+            {
+                throw std::out_of_range("LinkColumns::at");
+            }
+            return (*this)[i];
+        }
+
+        LinkGene back() const { return (*this)[size() - 1]; }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        void push_back(const LinkGene &link)
+        {
+            link_ids.push_back(Encoding::pack(link.link_id));
+            weights.push_back(Encoding::encode_value(link.weight));
+            innovations.push_back(link.innovation);
+            enabled.push_back(link.is_enabled);
+        }
+
+        const_iterator insert(const_iterator position, const LinkGene &link)
+        {
+            const std::size_t i = position.position();
+            link_ids.insert(link_ids.begin() + i, Encoding::pack(link.link_id));
+            weights.insert(weights.begin() + i, Encoding::encode_value(link.weight));
+            innovations.insert(innovations.begin() + i, link.innovation);
+            enabled.insert(enabled.begin() + i, link.is_enabled);
+            return const_iterator(this, i);
+        }
+
+        const_iterator erase(const_iterator position)
+        {
+            const std::size_t i = position.position();
+            link_ids.erase(link_ids.begin() + i);
+            weights.erase(weights.begin() + i);
+            innovations.erase(innovations.begin() + i);
+            enabled.erase(enabled.begin() + i);
+            return const_iterator(this, i);
+        }
+
+        // Remplace le lien d'indice i
+        void assign(std::size_t i, const LinkGene &link)
+        {
+            link_ids.at(i) = Encoding::pack(link.link_id);
+            weights[i] = Encoding::encode_value(link.weight);
+            innovations[i] = link.innovation;
+            enabled[i] = link.is_enabled;
+        }
+
+        void set_weight(std::size_t i, double weight) { weights.at(i) = Encoding::encode_value(weight); }
+        void set_enabled(std::size_t i, bool is_enabled) { enabled.at(i) = is_enabled; }
+
+        // Supprime les liens qui vérifient `predicate`, en conservant l'ordre des autres
+        template <typename Predicate>
+        void erase_if(Predicate predicate)
+        {
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < size(); ++i)
+            {
+                if (!predicate((*this)[i]))
+                {
+                    link_ids[kept] = link_ids[i];
+                    weights[kept] = weights[i];
+                    innovations[kept] = innovations[i];
+                    enabled[kept] = enabled[i];
+                    ++kept;
+                }
+            }
+            link_ids.resize(kept);
+            weights.resize(kept);
+            innovations.resize(kept);
+            enabled.resize(kept);
+        }
+
+        // Lecture d'un seul champ, pour les parcours qui n'ont besoin que de celui-ci
+        int innovation(std::size_t i) const { return innovations[i]; }
+        double weight(std::size_t i) const { return Encoding::decode_value(weights[i]); }
+
+    private:
+        std::pmr::vector<typename Encoding::LinkWord> link_ids; // Neurones d'entrée et de sortie
+        std::pmr::vector<typename Encoding::Value> weights;
+        std::pmr::vector<int> innovations;
+        std::pmr::vector<bool> enabled; // Vecteur de bits
+    };
+
+    /**
+     * @brief Neurones d'un génome en structure de tableaux.
+     */
+    template <typename Encoding>
+    class BasicNeuronColumns
+    {
+    public:
+        using value_type = NeuronGene;
+        using const_iterator = ColumnIterator<BasicNeuronColumns>;
+        using iterator = const_iterator;
+
+        BasicNeuronColumns() = default;
+        BasicNeuronColumns(std::pmr::memory_resource *resource)
+            : neuron_ids(resource), biases(resource), activations(resource) {}
+
+        std::size_t size() const { return neuron_ids.size(); }
+        bool empty() const { return neuron_ids.empty(); }
+
+        void reserve(std::size_t n)
+        {
+            neuron_ids.reserve(n);
+            biases.reserve(n);
+            activations.reserve(n);
+        }
+
+        NeuronGene operator[](std::size_t i) const
+        {
+            return NeuronGene{neuron_ids[i], bias(i), Activation(static_cast<Activation::Type>(activations[i]))};
+        }
+
+        NeuronGene at(std::size_t i) const
+        {
+            if (i >= size())
+            {
+                throw std::out_of_range("NeuronColumns::at");
+            }
+            return (*this)[i];
+        }
+
+        NeuronGene back() const { return (*this)[size() - 1]; }
+
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, size()); }
+
+        void push_back(const NeuronGene &neuron)
+        {
+            neuron_ids.push_back(neuron.neuron_id);
+            biases.push_back(Encoding::encode_value(neuron.bias));
+            activations.push_back(activation_code(neuron));
+        }
+
+        const_iterator insert(const_iterator position, const NeuronGene &neuron)
+        {
+            const std::size_t i = position.position();
+            neuron_ids.insert(neuron_ids.begin() + i, neuron.neuron_id);
+            biases.insert(biases.begin() + i, Encoding::encode_value(neuron.bias));
+            activations.insert(activations.begin() + i, activation_code(neuron));
+            return const_iterator(this, i);
+        }
+
+        const_iterator erase(const_iterator position)
+        {
+            const std::size_t i = position.position();
+            neuron_ids.erase(neuron_ids.begin() + i);
+            biases.erase(biases.begin() + i);
+            activations.erase(activations.begin() + i);
+            return const_iterator(this, i);
+        }
+
+        // Remplace le neurone d'indice i
+        void assign(std::size_t i, const NeuronGene &neuron)
+        {
+            neuron_ids.at(i) = neuron.neuron_id;
+            biases[i] = Encoding::encode_value(neuron.bias);
+            activations[i] = activation_code(neuron);
+        }
+
+        void set_bias(std::size_t i, double bias) { biases.at(i) = Encoding::encode_value(bias); }
+
+        int neuron_id(std::size_t i) const { return neuron_ids[i]; }
+        double bias(std::size_t i) const { return Encoding::decode_value(biases[i]); }
+
+    private:
+        static std::uint8_t activation_code(const NeuronGene &neuron)
+        {
+            return static_cast<std::uint8_t>(neuron.activation.get_type());
+        }
+
+        std::pmr::vector<int> neuron_ids;
+        std::pmr::vector<typename Encoding::Value> biases;
+        std::pmr::vector<std::uint8_t> activations; // Activation::Type
+    };
+
+    using LinkColumns = BasicLinkColumns<WideEncoding>;
+    using NeuronColumns = BasicNeuronColumns<WideEncoding>;
+
+    // Accès par champ : lecture directe de la colonne
+    template <typename Encoding>
+    int gene_key(const BasicLinkColumns<Encoding> &links, std::size_t i) { return links.innovation(i); }
+    template <typename Encoding>
+    int gene_key(const BasicNeuronColumns<Encoding> &neurons, std::size_t i) { return neurons.neuron_id(i); }
+    template <typename Encoding>
+    double link_weight(const BasicLinkColumns<Encoding> &links, std::size_t i) { return links.weight(i); }
+    template <typename Encoding>
+    double neuron_bias(const BasicNeuronColumns<Encoding> &neurons, std::size_t i) { return neurons.bias(i); }
+
+    // Modification d'un champ du gène d'indice i, quelle que soit la disposition
+    template <typename Allocator>
+    void set_link_weight(std::vector<LinkGene, Allocator> &links, std::size_t i, double weight) { links.at(i).weight = weight; }
+    template <typename Encoding>
+    void set_link_weight(BasicLinkColumns<Encoding> &links, std::size_t i, double weight) { links.set_weight(i, weight); }
+
+    template <typename Allocator>
+    void set_link_enabled(std::vector<LinkGene, Allocator> &links, std::size_t i, bool enabled) { links.at(i).is_enabled = enabled; }
+    template <typename Encoding>
+    void set_link_enabled(BasicLinkColumns<Encoding> &links, std::size_t i, bool enabled) { links.set_enabled(i, enabled); }
+
+    template <typename Allocator>
+    void set_neuron_bias(std::vector<NeuronGene, Allocator> &neurons, std::size_t i, double bias) { neurons.at(i).bias = bias; }
+    template <typename Encoding>
+    void set_neuron_bias(BasicNeuronColumns<Encoding> &neurons, std::size_t i, double bias) { neurons.set_bias(i, bias); }
+
+    // Suppression des gènes qui vérifient `predicate`, quelle que soit la disposition
+    template <typename Gene, typename Allocator, typename Predicate>
+    void erase_genes_if(std::vector<Gene, Allocator> &genes, Predicate predicate)
+    {
+        genes.erase(std::remove_if(genes.begin(), genes.end(), predicate), genes.end());
+    }
+
+    template <typename Encoding, typename Predicate>
+    void erase_genes_if(BasicLinkColumns<Encoding> &links, Predicate predicate)
+    {
+        links.erase_if(predicate);
+    }
+
+#if defined(NEAT_COMPACT_GENES)
+#if NEAT_COMPACT_GENES == 16
+    using GenomeEncoding = Fixed16Encoding;
+#else
+    using GenomeEncoding = CompactEncoding;
+#endif
+    using NeuronGenes = BasicNeuronColumns<GenomeEncoding>;
+    using LinkGenes = BasicLinkColumns<GenomeEncoding>;
+    constexpr int max_neuron_id = static_cast<int>((std::uint64_t(1) << GenomeEncoding::id_bits) - 1);
+#elif defined(NEAT_SOA_GENOMES)
+    using NeuronGenes = NeuronColumns;
+    using LinkGenes = LinkColumns;
+    constexpr int max_neuron_id = std::numeric_limits<int>::max();
+#else
+    using NeuronGenes = std::pmr::vector<NeuronGene>;
+    using LinkGenes = std::pmr::vector<LinkGene>;
+    constexpr int max_neuron_id = std::numeric_limits<int>::max();
+#endif
+} // namespace neat
+
+#endif // GENE_COLUMNS_H
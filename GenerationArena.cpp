@@ -0,0 +1,82 @@
+#include "GenerationArena.h"
+
+namespace {
+    thread_local std::pmr::memory_resource *current_resource = nullptr;
+
+    const std::size_t default_initial_bytes = 64 * 1024;
+}
+
+GenerationArena::GenerationArena(std::size_t num_workers, std::size_t initial_bytes_per_worker) {
+    const std::size_t initial_bytes = initial_bytes_per_worker > 0 ? initial_bytes_per_worker : default_initial_bytes;
+    for (std::size_t worker = 0; worker < num_workers; ++worker) {
+        workers.push_back(std::make_unique<WorkerResource>(initial_bytes));
+    }
+}
+
+std::size_t GenerationArena::num_workers() const {
+    return workers.size();
+}
+
+std::pmr::memory_resource *GenerationArena::resource(std::size_t worker) {
+    return workers.at(worker).get();
+}
+
+GenerationArena::Stats GenerationArena::get_stats() const {
+    Stats stats;
+    for (const auto &worker : workers) {
+        stats.allocations += worker->allocations;
+        stats.bytes += worker->bytes;
+        stats.chunks += worker->upstream.chunks;
+        stats.reserved_bytes += worker->upstream.reserved_bytes;
+    }
+    return stats;
+}
+
+std::pmr::memory_resource *GenerationArena::current() {
+    return current_resource ? current_resource : std::pmr::new_delete_resource();
+}
+
+GenerationArena::Scope::Scope(GenerationArena *arena, std::size_t worker) : previous(current_resource) {
+    if (arena) {
+        current_resource = arena->resource(worker);
+    }
+}
+
+GenerationArena::Scope::~Scope() {
+    current_resource = previous;
+}
+
+void *GenerationArena::CountingUpstream::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++chunks;
+    reserved_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void GenerationArena::CountingUpstream::do_deallocate(void *p, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool GenerationArena::CountingUpstream::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+GenerationArena::WorkerResource::WorkerResource(std::size_t initial_bytes) : monotonic(initial_bytes, &upstream) {}
+
+void *GenerationArena::WorkerResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    ++allocations;
+    this->bytes += bytes;
+    return monotonic.allocate(bytes, alignment);
+}
+
+void GenerationArena::WorkerResource::do_deallocate(void *, std::size_t, std::size_t) {
+    // Libéré en bloc avec l'arène
+}
+
+bool GenerationArena::WorkerResource::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+void GenerationArena::Stats::print(std::ostream &out) const {
+    out << "Arène de la génération : " << allocations << " allocations, " << bytes / 1024 << " Ko demandés, "
+        << chunks << " blocs (" << reserved_bytes / 1024 << " Ko réservés)" << std::endl;
+}
@@ -0,0 +1,156 @@
+#ifndef GENERATION_ARENA_H
+#define GENERATION_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Arène mémoire d'une génération : les génomes des descendants et leurs gènes y sont alloués
+ * par simple incrément de pointeur, puis libérés en bloc.
+ *
+ * Chaque worker dispose de sa propre zone (les zones ne sont pas synchronisées). Les génomes créés par
+ * `make_shared` gardent l'arène en vie : elle est libérée d'un coup lorsque le dernier génome de la
+ * génération disparaît, en pratique au `replace_population` suivant. Population alterne ainsi entre
+ * l'arène de la génération courante et celle de la génération en cours de production.
+ *
+ * Les conteneurs d'un Genome utilisent la ressource mémoire « courante » du thread (voir `current`),
+ * que `Scope` redirige vers l'arène le temps de produire un descendant. Une copie de génome
+ * utilise toujours le tas : elle ne dépend pas de l'arène de l'original.
+ */
+class GenerationArena
+{
+public:
+    // Statistiques cumulées sur tous les workers
+    struct Stats
+    {
+        std::size_t allocations = 0;    // Allocations servies par l'arène
+        std::size_t bytes = 0;          // Octets demandés
+        std::size_t chunks = 0;         // Blocs obtenus du tas
+        std::size_t reserved_bytes = 0; // Octets obtenus du tas
+
+        void print(std::ostream &out) const;
+    };
+
+    /**
+     * @brief Construit une arène vide.
+     *
+     * @param num_workers Le nombre de workers qui y allouent.
+     * @param initial_bytes_per_worker Taille du premier bloc de chaque worker (0 : taille par défaut),
+     *        par exemple la consommation de la génération précédente.
+     */
+    GenerationArena(std::size_t num_workers, std::size_t initial_bytes_per_worker = 0);
+
+    GenerationArena(const GenerationArena &) = delete;
+    GenerationArena &operator=(const GenerationArena &) = delete;
+
+    std::size_t num_workers() const;
+    std::pmr::memory_resource *resource(std::size_t worker);
+    Stats get_stats() const;
+
+    /**
+     * @brief Retourne la ressource mémoire courante du thread : l'arène d'un `Scope` actif, sinon le tas.
+     */
+    static std::pmr::memory_resource *current();
+
+    /**
+     * @brief Redirige les allocations des génomes du thread vers la zone d'un worker, jusqu'à sa destruction.
+     *
+     * Sans arène (pointeur nul), la ressource courante est inchangée.
+     */
+    class Scope
+    {
+    public:
+        Scope(GenerationArena *arena, std::size_t worker);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        std::pmr::memory_resource *previous;
+    };
+
+    /**
+     * @brief Alloue un objet partagé dans la zone d'un worker ; le bloc de contrôle garde l'arène en vie.
+     */
+    template <typename T, typename... Args>
+    static std::shared_ptr<T> make_shared(const std::shared_ptr<GenerationArena> &arena, std::size_t worker, Args &&...args)
+    {
+        return std::allocate_shared<T>(Allocator<T>(arena, worker), std::forward<Args>(args)...);
+    }
+
+private:
+    // Allocateur des objets partagés : il détient une référence sur l'arène
+    template <typename T>
+    class Allocator
+    {
+    public:
+        using value_type = T;
+
+        Allocator(std::shared_ptr<GenerationArena> arena, std::size_t worker)
+            : arena(std::move(arena)), worker(worker) {}
+
+        template <typename U>
+        Allocator(const Allocator<U> &other) : arena(other.arena), worker(other.worker) {}
+
+        T *allocate(std::size_t n)
+        {
+            return static_cast<T *>(arena->resource(worker)->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T *, std::size_t)
+        {
+            // Libéré en bloc avec l'arène
+        }
+
+        template <typename U>
+        bool operator==(const Allocator<U> &other) const { return arena == other.arena; }
+        template <typename U>
+        bool operator!=(const Allocator<U> &other) const { return arena != other.arena; }
+
+    private:
+        template <typename U>
+        friend class Allocator;
+
+        std::shared_ptr<GenerationArena> arena;
+        std::size_t worker;
+    };
+
+    // Compte les blocs obtenus du tas
+    class CountingUpstream : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t chunks = 0;
+        std::size_t reserved_bytes = 0;
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    // Zone d'un worker : allocation par incrément, désallocations ignorées
+    class WorkerResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit WorkerResource(std::size_t initial_bytes);
+
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+        CountingUpstream upstream;
+        std::pmr::monotonic_buffer_resource monotonic;
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+    };
+
+    std::vector<std::unique_ptr<WorkerResource>> workers;
+};
+
+#endif // GENERATION_ARENA_H
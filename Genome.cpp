@@ -1,46 +1,161 @@
 #include "Genome.h"
 #include "neat.h"
+#include "InnovationTracker.h"
+#include "GenerationArena.h"
 #include <optional>
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
 
 // Constructeur par défaut
-Genome::Genome() : genome_id(0), num_inputs(0), num_outputs(0) {}
+Genome::Genome() : Genome(0, 0, 0) {}
 
 Genome::Genome(int id, int num_inputs, int num_outputs)
-    : genome_id(id), num_inputs(num_inputs), num_outputs(num_outputs) {}
+    : genome_id(id), num_inputs(num_inputs), num_outputs(num_outputs),
+      parameter_changes(GenerationArena::current()),
+      neurons(GenerationArena::current()), links(GenerationArena::current()),
+      neuron_index(GenerationArena::current()), link_index(GenerationArena::current()),
+      topological_order(GenerationArena::current()),
+      successors(GenerationArena::current()), predecessors(GenerationArena::current()) {}
 
-// Crée un nouveau génome avec les neurones d'entrée, de sortie et un certain nombre de neurones cachés
 // Fonction auxiliaire pour vérifier si un lien créerait un cycle
 bool Genome::would_create_cycle(int input_id, int output_id) const {
-    std::unordered_set<int> visited;
-    std::unordered_map<int, std::vector<int>> graph;
+    if (input_id == output_id) {
+        return true;
+    }
 
-    // Construire le graphe actuel des connexions
-    for (const auto &link : links) {
-        if (link.is_enabled) {
-            graph[link.link_id.input_id].push_back(link.link_id.output_id);
+    auto input_it = topological_order.find(input_id);
+    auto output_it = topological_order.find(output_id);
+    if (input_it == topological_order.end() || output_it == topological_order.end()) {
+        return false;  // Un neurone sans rang n'a encore aucun lien
+    }
+
+    // Cas courant : l'ordre existant reste valide avec le nouveau lien
+    int bound = input_it->second;
+    if (output_it->second > bound) {
+        return false;
+    }
+
+    // Recherche d'un chemin output_id -> input_id, limitée aux neurones de rang <= rang(input_id)
+    std::vector<int> stack{output_id};
+    std::unordered_set<int> visited{output_id};
+    while (!stack.empty()) {
+        int current = stack.back();
+        stack.pop_back();
+        if (current == input_id) {
+            return true;
+        }
+        auto succ_it = successors.find(current);
+        if (succ_it == successors.end()) {
+            continue;
+        }
+        for (int next : succ_it->second) {
+            if (topological_order.at(next) <= bound && visited.insert(next).second) {
+                stack.push_back(next);
+            }
         }
     }
+    return false;
+}
 
-    // Effectuer une recherche en profondeur pour voir s'il existe un chemin de output_id vers input_id
-    std::function<bool(int)> dfs = [&](int current) {
-        if (current == input_id) return true;
-        if (visited.count(current)) return false;
+int Genome::order_of(int neuron_id) {
+    auto it = topological_order.find(neuron_id);
+    if (it != topological_order.end()) {
+        return it->second;
+    }
+    topological_order.emplace(neuron_id, next_order);
+    return next_order++;
+}
 
-        visited.insert(current);
-        for (int neighbor : graph[current]) {
-            if (dfs(neighbor)) return true;
+void Genome::insert_edge(int input_id, int output_id) {
+    int lower = order_of(output_id);
+    int upper = order_of(input_id);
+
+    if (lower <= upper) {
+        // Réordonnancement de Pearce et Kelly : seuls les neurones dont le rang est compris
+        // entre rang(output_id) et rang(input_id) peuvent être déplacés.
+        std::vector<int> forward;   // Atteignables depuis output_id
+        std::vector<int> backward;  // Qui atteignent input_id
+        std::unordered_set<int> visited{output_id};
+        std::vector<int> stack{output_id};
+        while (!stack.empty()) {
+            int current = stack.back();
+            stack.pop_back();
+            if (current == input_id) {
+                throw std::runtime_error("Genome: le lien créerait un cycle.");
+            }
+            forward.push_back(current);
+            for (int next : successors[current]) {
+                if (topological_order.at(next) <= upper && visited.insert(next).second) {
+                    stack.push_back(next);
+                }
+            }
         }
-        return false;
-    };
 
-    return dfs(output_id);
+        visited = {input_id};
+        stack = {input_id};
+        while (!stack.empty()) {
+            int current = stack.back();
+            stack.pop_back();
+            backward.push_back(current);
+            for (int previous : predecessors[current]) {
+                if (topological_order.at(previous) >= lower && visited.insert(previous).second) {
+                    stack.push_back(previous);
+                }
+            }
+        }
+
+        // Les rangs libérés sont réattribués : d'abord aux ancêtres d'input_id, puis aux descendants d'output_id
+        auto by_order = [this](int a, int b) { return topological_order.at(a) < topological_order.at(b); };
+        std::sort(forward.begin(), forward.end(), by_order);
+        std::sort(backward.begin(), backward.end(), by_order);
+
+        std::vector<int> ranks;
+        ranks.reserve(forward.size() + backward.size());
+        for (int neuron_id : backward) ranks.push_back(topological_order.at(neuron_id));
+        for (int neuron_id : forward) ranks.push_back(topological_order.at(neuron_id));
+        std::sort(ranks.begin(), ranks.end());
+
+        std::size_t r = 0;
+        for (int neuron_id : backward) topological_order[neuron_id] = ranks[r++];
+        for (int neuron_id : forward) topological_order[neuron_id] = ranks[r++];
+    }
+
+    successors[input_id].push_back(output_id);
+    predecessors[output_id].push_back(input_id);
+}
+
+void Genome::erase_edge(int input_id, int output_id) {
+    // Retirer un lien ne peut pas invalider l'ordre topologique
+    auto &out = successors[input_id];
+    auto out_it = std::find(out.begin(), out.end(), output_id);
+    if (out_it != out.end()) {
+        out.erase(out_it);
+    }
+    auto &in = predecessors[output_id];
+    auto in_it = std::find(in.begin(), in.end(), input_id);
+    if (in_it != in.end()) {
+        in.erase(in_it);
+    }
+}
+
+void Genome::rebuild_graph() {
+    successors.clear();
+    predecessors.clear();
+    for (const auto &link : links) {
+        successors[link.link_id.input_id].push_back(link.link_id.output_id);
+        predecessors[link.link_id.output_id].push_back(link.link_id.input_id);
+    }
 }
 
 // Fonction de création du génome avec vérification des cycles
-Genome Genome::create_genome(int id, int num_inputs, int num_outputs, int num_hidden_neurons, RNG &rng) {
+Genome Genome::create_genome(int id, int num_inputs, int num_outputs, int num_hidden_neurons, RNG &rng,
+                             InnovationTracker &innovations) {
     Genome genome(id, num_inputs, num_outputs);
 
     // Ajoute neurones d'entrée
@@ -58,13 +173,14 @@ Genome Genome::create_genome(int id, int num_inputs, int num_outputs, int num_hi
     for (int i = 0; i < num_hidden_neurons; ++i) {
         int hidden_id = num_inputs + num_outputs + i;
         genome.add_neuron(neat::NeuronGene{hidden_id, 0.0, Activation(Activation::Type::Sigmoid)});
+        innovations.register_neuron_id(hidden_id);
     }
 
     // Liens : entrée -> cachés
     for (int input_id = 0; input_id < num_inputs; ++input_id) {
         for (int hidden_id = num_inputs + num_outputs; hidden_id < num_inputs + num_outputs + num_hidden_neurons; ++hidden_id) {
             if (!genome.would_create_cycle(input_id, hidden_id)) {
-                genome.add_link(genome.create_link(input_id, hidden_id, rng));
+                genome.add_link(genome.create_link(input_id, hidden_id, rng, innovations));
             }
         }
     }
@@ -73,7 +189,7 @@ Genome Genome::create_genome(int id, int num_inputs, int num_outputs, int num_hi
     for (int hidden_id = num_inputs + num_outputs; hidden_id < num_inputs + num_outputs + num_hidden_neurons; ++hidden_id) {
         for (int target_hidden_id = hidden_id + 1; target_hidden_id < num_inputs + num_outputs + num_hidden_neurons; ++target_hidden_id) {
             if (!genome.would_create_cycle(hidden_id, target_hidden_id)) {
-                genome.add_link(genome.create_link(hidden_id, target_hidden_id, rng));
+                genome.add_link(genome.create_link(hidden_id, target_hidden_id, rng, innovations));
             }
         }
     }
@@ -82,7 +198,7 @@ Genome Genome::create_genome(int id, int num_inputs, int num_outputs, int num_hi
     for (int hidden_id = num_inputs + num_outputs; hidden_id < num_inputs + num_outputs + num_hidden_neurons; ++hidden_id) {
         for (int output_id = num_inputs; output_id < num_inputs + num_outputs; ++output_id) {
             if (!genome.would_create_cycle(hidden_id, output_id)) {
-                genome.add_link(genome.create_link(hidden_id, output_id, rng));
+                genome.add_link(genome.create_link(hidden_id, output_id, rng, innovations));
             }
         }
     }
@@ -108,8 +224,9 @@ Genome Genome::create_genome(int id, int num_inputs, int num_outputs, int num_hi
 
 
 // Crée un lien avec des poids aléatoires
-neat::LinkGene Genome::create_link(int input_id, int output_id, RNG &rng) {
-    return neat::LinkGene{{input_id, output_id}, rng.next_gaussian(0.0, 1.0), true};
+neat::LinkGene Genome::create_link(int input_id, int output_id, RNG &rng, InnovationTracker &innovations) {
+    neat::LinkId link_id{input_id, output_id};
+    return neat::LinkGene{link_id, rng.next_gaussian(0.0, 1.0), true, innovations.link_innovation(link_id)};
 }
 
 neat::NeuronGene Genome::create_neuron(int neuron_id) {
@@ -129,20 +246,89 @@ int Genome::get_genome_id() const {
     return genome_id;  // Retourne l'ID du génome
 }
 
-std::vector<neat::NeuronGene> Genome::get_neurons() const {
+const neat::NeuronGenes &Genome::get_neurons() const {
     return neurons;  // Retourne les neurones du génome
 }
 
-std::vector<neat::LinkGene> Genome::get_links() const {
+const neat::LinkGenes &Genome::get_links() const {
     return links;  // Retourne les liens du génome
 }
 
-std::vector<neat::NeuronGene>& Genome::get_neurons() {
-    return neurons;  // Retourne les neurones du génome
+bool Genome::remove_link(neat::LinkId link_id) {
+    auto it = link_index.find(link_id);
+    if (it == link_index.end()) {
+        return false;
+    }
+    links.erase(links.begin() + it->second);
+    rebuild_link_index();
+    erase_edge(link_id.input_id, link_id.output_id);
+    structure_changed();
+    return true;
 }
 
-std::vector<neat::LinkGene>& Genome::get_links() {
-    return links;  // Retourne les liens du génome
+bool Genome::remove_neuron(int neuron_id) {
+    auto it = neuron_index.find(neuron_id);
+    if (it == neuron_index.end()) {
+        return false;
+    }
+    neurons.erase(neurons.begin() + it->second);
+    rebuild_neuron_index();
+
+    neat::erase_genes_if(links, [neuron_id](const neat::LinkGene &link) {
+        return link.link_id.input_id == neuron_id || link.link_id.output_id == neuron_id;
+    });
+    rebuild_link_index();
+    topological_order.erase(neuron_id);
+    rebuild_graph();
+
+    structure_changed();
+    return true;
+}
+
+bool Genome::set_link_enabled(neat::LinkId link_id, bool enabled) {
+    auto it = link_index.find(link_id);
+    if (it == link_index.end()) {
+        return false;
+    }
+    if (links[it->second].is_enabled != enabled) {
+        neat::set_link_enabled(links, it->second, enabled);
+        structure_changed();
+    }
+    return true;
+}
+
+void Genome::set_link_weight(std::size_t link_index, double weight) {
+    neat::set_link_weight(links, link_index, weight);
+    parameter_changed(true, link_index);
+}
+
+void Genome::set_neuron_bias(std::size_t neuron_index, double bias) {
+    neat::set_neuron_bias(neurons, neuron_index, bias);
+    parameter_changed(false, neuron_index);
+}
+
+// Les positions des gènes ne valent que pour une structure : le journal des paramètres repart de zéro
+void Genome::structure_changed() {
+    ++structure_version;
+    parameter_changes.clear();
+    parameter_changes_base = parameter_version;
+}
+
+void Genome::parameter_changed(bool is_link, std::size_t index) {
+    ++parameter_version;
+    if (parameter_changes.size() == max_parameter_changes) {
+        parameter_changes.clear();
+        parameter_changes_base = parameter_version - 1;
+    }
+    parameter_changes.push_back(ParameterChange{is_link, index});
+}
+
+unsigned long Genome::get_structure_version() const {
+    return structure_version;
+}
+
+unsigned long Genome::get_parameter_version() const {
+    return parameter_version;
 }
 
 int Genome::generate_next_neuron_id() {
@@ -157,31 +343,140 @@ int Genome::generate_next_neuron_id() {
 
 // Ajout des fonctions de gestion de neurones et liens
 void Genome::add_neuron(const neat::NeuronGene &neuron) {
-    neurons.push_back(neuron);
+    order_of(neuron.neuron_id);
+    if (neurons.empty() || neurons.back().neuron_id <= neuron.neuron_id) {
+        neuron_index.emplace(neuron.neuron_id, neurons.size());  // En cas de doublon, le premier reste indexé
+        neurons.push_back(neuron);
+    } else {
+        // Insertion au milieu : garde la liste triée par identifiant
+        auto position = std::upper_bound(neurons.begin(), neurons.end(), neuron.neuron_id,
+            [](int neuron_id, const neat::NeuronGene &other) { return neuron_id < other.neuron_id; });
+        neurons.insert(position, neuron);
+        rebuild_neuron_index();
+    }
+    structure_changed();
 }
 
 void Genome::add_link(const neat::LinkGene &link) {
-    links.push_back(link);
+    insert_edge(link.link_id.input_id, link.link_id.output_id);  // Lève une exception avant toute modification si cycle
+    if (links.empty() || links.back().innovation <= link.innovation) {
+        link_index.emplace(link.link_id, links.size());  // En cas de doublon, le premier reste indexé
+        links.push_back(link);
+    } else {
+        // Insertion au milieu : garde la liste triée par numéro d'innovation
+        auto position = std::upper_bound(links.begin(), links.end(), link.innovation,
+            [](int innovation, const neat::LinkGene &other) { return innovation < other.innovation; });
+        links.insert(position, link);
+        rebuild_link_index();
+    }
+    structure_changed();
+}
+
+void Genome::reserve(std::size_t num_neurons, std::size_t num_links) {
+    neurons.reserve(num_neurons);
+    links.reserve(num_links);
+    neuron_index.reserve(num_neurons);
+    link_index.reserve(num_links);
+    topological_order.reserve(num_neurons);
+    successors.reserve(num_neurons);
+    predecessors.reserve(num_neurons);
+}
+
+void Genome::rebuild_neuron_index() {
+    neuron_index.clear();
+    for (std::size_t i = 0; i < neurons.size(); ++i) {
+        neuron_index.emplace(neurons[i].neuron_id, i);
+    }
+}
+
+void Genome::rebuild_link_index() {
+    link_index.clear();
+    for (std::size_t i = 0; i < links.size(); ++i) {
+        link_index.emplace(links[i].link_id, i);
+    }
 }
 
 // Recherche un neurone dans le génome par ID
 std::optional<neat::NeuronGene> Genome::find_neuron(int neuron_id) const {
-    for (const auto &neuron : neurons) {
-        if (neuron.neuron_id == neuron_id) {
-            return neuron;  // Retourne le neurone s'il est trouvé
-        }
+    auto it = neuron_index.find(neuron_id);
+    if (it == neuron_index.end()) {
+        return std::nullopt;  // Retourne un optional vide si non trouvé
     }
-    return std::nullopt;  // Retourne un optional vide si non trouvé
+    return neurons[it->second];  // Retourne le neurone s'il est trouvé
 }
 
 // Recherche un lien dans le génome par ID de lien
 std::optional<neat::LinkGene> Genome::find_link(neat::LinkId link_id) const {
+    auto it = link_index.find(link_id);
+    if (it == link_index.end()) {
+        return std::nullopt;  // Retourne un optional vide si non trouvé
+    }
+    return links[it->second];  // Retourne le lien s'il est trouvé
+}
+
+namespace {
+    // Mélange de bits (splitmix64) utilisé pour combiner les empreintes des gènes
+    std::uint64_t mix_bits(std::uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+}
+
+std::size_t Genome::structural_hash() const {
+    // Somme des empreintes des gènes : indépendante de l'ordre des vecteurs
+    std::uint64_t neuron_sum = 0;
+    for (const auto &neuron : neurons) {
+        std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(neuron.neuron_id)) << 8)
+                          | static_cast<std::uint64_t>(neuron.activation.get_type());
+        neuron_sum += mix_bits(key);
+    }
+
+    std::uint64_t link_sum = 0;
+    std::uint64_t num_enabled = 0;
+    for (const auto &link : links) {
+        if (link.is_enabled) {
+            std::uint64_t key = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(link.link_id.input_id)) << 32)
+                              | static_cast<std::uint32_t>(link.link_id.output_id);
+            link_sum += mix_bits(key);
+            ++num_enabled;
+        }
+    }
+
+    std::uint64_t h = mix_bits(static_cast<std::uint64_t>(num_inputs) << 32 | static_cast<std::uint32_t>(num_outputs));
+    h = mix_bits(h ^ neuron_sum);
+    h = mix_bits(h ^ link_sum ^ (num_enabled << 1));
+    return static_cast<std::size_t>(h);
+}
+
+namespace {
+    // Bits d'un réel, avec -0.0 ramené à 0.0 pour que deux valeurs égales aient la même empreinte
+    std::uint64_t value_bits(double value) {
+        value += 0.0;
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+std::uint64_t Genome::content_hash() const {
+    // Les gènes sont triés (neurones par identifiant, liens par innovation) : un parcours
+    // séquentiel suffit à obtenir une empreinte canonique
+    std::uint64_t h = mix_bits(static_cast<std::uint64_t>(num_inputs) << 32 | static_cast<std::uint32_t>(num_outputs));
+    for (const auto &neuron : neurons) {
+        h = mix_bits(h ^ static_cast<std::uint32_t>(neuron.neuron_id));
+        h = mix_bits(h ^ static_cast<std::uint64_t>(neuron.activation.get_type()));
+        h = mix_bits(h ^ value_bits(neuron.bias));
+    }
     for (const auto &link : links) {
-        if (link.link_id.input_id == link_id.input_id && link.link_id.output_id == link_id.output_id) {
-            return link;  // Retourne le lien s'il est trouvé
+        if (link.is_enabled) {
+            h = mix_bits(h ^ ((static_cast<std::uint64_t>(static_cast<std::uint32_t>(link.link_id.input_id)) << 32)
+                              | static_cast<std::uint32_t>(link.link_id.output_id)));
+            h = mix_bits(h ^ value_bits(link.weight));
         }
     }
-    return std::nullopt;  // Retourne un optional vide si non trouvé
+    return h;
 }
 
 // Génère un vecteur contenant les identifiants des nœuds d’entrée
@@ -2,10 +2,16 @@
 #define GENOME_H
 
 #include "neat.h"
+#include "GeneColumns.h"
 #include "Activation.h"
 #include "rng.h"
 #include <vector>
 #include <optional>
+#include <cstdint>
+#include <unordered_map>
+#include <memory_resource>
+
+class InnovationTracker;
 
 class Genome
 {
@@ -29,10 +35,23 @@ public:
      */
     Genome(int id, int num_inputs, int num_outputs);
 
+    /**
+     * @brief Vérifie si l’ajout du lien `input_id` -> `output_id` créerait un cycle.
+     *
+     * Le génome maintient un ordre topologique de ses neurones, mis à jour à chaque ajout de lien
+     * (algorithme de Pearce et Kelly). Si `input_id` précède `output_id` dans cet ordre, la réponse
+     * est immédiate ; sinon, seule la région de l’ordre comprise entre les deux neurones est explorée.
+     * Tous les liens sont pris en compte, y compris les liens désactivés, qui peuvent être réactivés.
+     *
+     * @param input_id L’ID du neurone d’entrée du lien à ajouter.
+     * @param output_id L’ID du neurone de sortie du lien à ajouter.
+     * @return true si l’ajout du lien créerait un cycle, false sinon.
+     */
     bool would_create_cycle(int input_id, int output_id) const;
 
-    // Méthodes statiques pour créer un génome
-    static Genome create_genome(int id, int num_inputs, int num_outputs, int num_hidden_neurons, RNG &rng);
+    // Méthodes statiques pour créer un génome ; les liens reçoivent leur numéro d'innovation de `innovations`
+    static Genome create_genome(int id, int num_inputs, int num_outputs, int num_hidden_neurons, RNG &rng,
+                                InnovationTracker &innovations);
 
     /**
      * @brief Obtenir le nombre d’entrées dans le génome.
@@ -60,26 +79,121 @@ public:
     int get_genome_id() const;
 
     /**
-     * @brief Récupère les neurones du génome.
+     * @brief Récupère les neurones du génome, sans copie.
+     *
+     * La référence reste valide tant que le génome existe, mais tout ajout ou suppression
+     * de gène peut invalider les itérateurs obtenus.
+     *
+     * @return const neat::NeuronGenes& Les neurones du génome, triés par identifiant.
+     */
+    const neat::NeuronGenes &get_neurons() const;
+
+    /**
+     * @brief Récupère les liens du génome, sans copie.
+     *
+     * @return const neat::LinkGenes& Les liens du génome, triés par numéro d'innovation.
+     */
+    const neat::LinkGenes &get_links() const;
+
+    /**
+     * @brief Supprime un lien du génome.
+     *
+     * @param link_id L'identifiant du lien à supprimer.
+     * @return true si le lien existait.
+     */
+    bool remove_link(neat::LinkId link_id);
+
+    /**
+     * @brief Supprime un neurone et tous les liens qui le touchent.
+     *
+     * @param neuron_id L'identifiant du neurone à supprimer.
+     * @return true si le neurone existait.
+     */
+    bool remove_neuron(int neuron_id);
+
+    /**
+     * @brief Active ou désactive un lien existant.
+     *
+     * @param link_id L'identifiant du lien.
+     * @param enabled Le nouvel état du lien.
+     * @return true si le lien existe.
+     */
+    bool set_link_enabled(neat::LinkId link_id, bool enabled);
+
+    /**
+     * @brief Modifie le poids d'un lien sans toucher à la structure du génome.
      *
-     * @return std::vector<neat::NeuronGene> Les neurones du génome.
+     * @param link_index L'index du lien dans le vecteur des liens.
+     * @param weight Le nouveau poids.
      */
-    std::vector<neat::NeuronGene> get_neurons() const;
+    void set_link_weight(std::size_t link_index, double weight);
 
     /**
-     * @brief Récupère les liens du génome.
+     * @brief Modifie le biais d'un neurone sans toucher à la structure du génome.
      *
-     * @return std::vector<neat::LinkGene> Les liens du génome.
+     * @param neuron_index L'index du neurone dans le vecteur des neurones.
+     * @param bias Le nouveau biais.
      */
-    std::vector<neat::LinkGene> get_links() const;
+    void set_neuron_bias(std::size_t neuron_index, double bias);
 
-    std::vector<neat::NeuronGene>& get_neurons();
-    std::vector<neat::LinkGene>& get_links();
+    /**
+     * @brief Récupère la version structurelle du génome.
+     *
+     * Elle est incrémentée à chaque modification de la structure (ajout, suppression, activation ou
+     * désactivation de gène). Avec l'identifiant du génome, elle identifie une topologie donnée.
+     *
+     * @return unsigned long La version structurelle courante.
+     */
+    unsigned long get_structure_version() const;
+
+    /**
+     * @brief Récupère la version des paramètres (poids et biais) du génome.
+     *
+     * Elle est incrémentée par `set_link_weight` et `set_neuron_bias`.
+     *
+     * @return unsigned long La version courante des paramètres.
+     */
+    unsigned long get_parameter_version() const;
+
+    // Gène dont le poids ou le biais a été modifié (voir `for_each_parameter_change`)
+    struct ParameterChange
+    {
+        bool is_link;      // true : poids du lien `index`, false : biais du neurone `index`
+        std::size_t index; // Position du gène dans get_links() ou get_neurons()
+    };
+
+    // Nombre de modifications de paramètres gardées en mémoire depuis la dernière modification structurelle
+    static constexpr std::size_t max_parameter_changes = 64;
+
+    /**
+     * @brief Parcourt les poids et biais modifiés depuis une version donnée des paramètres.
+     *
+     * Permet de ne recopier dans un réseau compilé que les gènes modifiés. Les modifications sont oubliées
+     * à chaque modification structurelle et au-delà de `max_parameter_changes`.
+     *
+     * @param since Une version des paramètres obtenue sous la version structurelle courante.
+     * @param visit Appelée pour chaque ParameterChange, dans l'ordre des modifications.
+     * @return false si les modifications depuis `since` ne sont plus toutes connues ; rien n'est alors parcouru.
+     */
+    template <typename Visit>
+    bool for_each_parameter_change(unsigned long since, Visit &&visit) const
+    {
+        if (since < parameter_changes_base || since > parameter_version)
+        {
+            return false;
+        }
+        for (std::size_t i = since - parameter_changes_base; i < parameter_changes.size(); i++)
+        {
+            visit(parameter_changes[i]);
+        }
+        return true;
+    }
 
     /**
      * @brief Ajoute un neurone au génome.
      *
      * Cette fonction ajoute un gène de neurone donné à la liste des neurones du génome.
+     * La liste reste triée par identifiant : l'ajout en fin de liste (cas du croisement) est en temps constant.
      *
      * @param neuron Le gène neurone à ajouter.
      */
@@ -88,13 +202,29 @@ public:
     /**
      * @brief Ajoute un lien donné à la liste des liens dans le génome.
      *
-     * TCette fonction ajoute un gène de lien donné à la liste des liens du génome.
+     * Cette fonction ajoute un gène de lien donné à la liste des liens du génome.
+     * La liste reste triée par numéro d'innovation : l'ajout en fin de liste (cas du croisement) est en temps constant.
+     * L'ordre topologique des neurones est mis à jour localement.
      *
      * @param link Le gène de lien à ajouter.
+     * @throws std::runtime_error Si le lien crée un cycle.
      */
     void add_link(const neat::LinkGene &link);
 
-    // Recherche de neurones et de liens
+    /**
+     * @brief Réserve la place de `num_neurons` neurones et `num_links` liens.
+     *
+     * Évite les réallocations successives des vecteurs et des index pendant la construction d'un
+     * génome, en particulier dans une arène où la mémoire abandonnée n'est pas réutilisée.
+     */
+    void reserve(std::size_t num_neurons, std::size_t num_links);
+
+    /**
+     * @brief Recherche de neurones et de liens par identifiant.
+     *
+     * Les recherches passent par un index (identifiant -> position) maintenu par les méthodes
+     * qui modifient les gènes, et s'effectuent donc en temps constant.
+     */
     std::optional<neat::NeuronGene> find_neuron(int neuron_id) const;
     std::optional<neat::LinkGene> find_link(neat::LinkId link_id) const;
 
@@ -113,6 +243,29 @@ public:
     std::vector<int> make_input_ids() const;
     std::vector<int> make_output_ids() const;
 
+    /**
+     * @brief Calcule une empreinte de la structure du génome.
+     *
+     * L'empreinte couvre les neurones (identifiant et type d'activation) et les liens activés,
+     * mais ni les poids ni les biais : deux génomes qui ne diffèrent que par leurs valeurs
+     * numériques ont la même empreinte. Elle ne dépend pas de l'ordre des gènes.
+     *
+     * @return std::size_t L'empreinte structurelle du génome.
+     */
+    std::size_t structural_hash() const;
+
+    /**
+     * @brief Calcule une empreinte canonique du contenu du génome.
+     *
+     * Contrairement à `structural_hash`, l'empreinte couvre aussi les poids et les biais : deux génomes
+     * qui codent le même réseau (mêmes neurones, mêmes liens activés, mêmes valeurs) ont la même
+     * empreinte, quels que soient leur identifiant et leurs liens désactivés. Elle sert de clé à la
+     * table de transposition des fitness (FitnessCache).
+     *
+     * @return std::uint64_t L'empreinte du contenu du génome.
+     */
+    std::uint64_t content_hash() const;
+
     /**
      * @brief Crée un nouveau lien avec les identifiants de neurones spécifiés.
      *
@@ -121,9 +274,10 @@ public:
      *
      * @param input_id L'identifiant du neurone d'entrée pour le lien.
      * @param output_id L'identifiant du neurone de sortie pour le lien.
+     * @param innovations Le registre des numéros d'innovation de la population.
      * @return neat::LinkGene Une structure LinkGene représentant le lien nouvellement créé.
      */
-    neat::LinkGene create_link(int input_id, int output_id, RNG &rng);
+    neat::LinkGene create_link(int input_id, int output_id, RNG &rng, InnovationTracker &innovations);
 
     /**
      * @brief Crée un nouveau neurone avec l'identifiant de neurone spécifié.
@@ -140,10 +294,38 @@ private:
     int genome_id;
     int num_inputs;
     int num_outputs;
+    unsigned long structure_version = 0; // Incrémentée à chaque modification de la structure
+    unsigned long parameter_version = 0; // Incrémentée à chaque modification d'un poids ou d'un biais
+
+    // Modifications de paramètres depuis la version `parameter_changes_base` : la i-ème donne la version
+    // parameter_changes_base + i + 1
+    std::pmr::vector<ParameterChange> parameter_changes;
+    unsigned long parameter_changes_base = 0;
+
+    // Vecteurs de neurones et de liens dans le génome. Tous les conteneurs du génome utilisent la
+    // ressource mémoire courante à sa construction (le tas, ou l'arène de la génération en cours)
+    neat::NeuronGenes neurons;
+    neat::LinkGenes links;
+
+    // Index des gènes : identifiant -> position dans les vecteurs ci-dessus
+    std::pmr::unordered_map<int, std::size_t> neuron_index;
+    std::pmr::unordered_map<neat::LinkId, std::size_t, neat::LinkIdHash> link_index;
+
+    // Ordre topologique des neurones (identifiant -> rang) et graphe de tous les liens, maintenus à chaque
+    // ajout de lien pour répondre à `would_create_cycle` sans reconstruire le graphe
+    std::pmr::unordered_map<int, int> topological_order;
+    int next_order = 0;
+    std::pmr::unordered_map<int, std::pmr::vector<int>> successors;
+    std::pmr::unordered_map<int, std::pmr::vector<int>> predecessors;
 
-    // Vecteurs de neurones et de liens dans le génome
-    std::vector<neat::NeuronGene> neurons;
-    std::vector<neat::LinkGene> links;
+    void structure_changed();
+    void parameter_changed(bool is_link, std::size_t index);
+    void rebuild_neuron_index();
+    void rebuild_link_index();
+    void rebuild_graph();
+    int order_of(int neuron_id);
+    void insert_edge(int input_id, int output_id);
+    void erase_edge(int input_id, int output_id);
 };
 
 #endif // GENOME_H
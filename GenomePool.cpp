@@ -0,0 +1,107 @@
+#include "GenomePool.h"
+#include <stdexcept>
+
+std::vector<GenomePool::Handle> GenomePool::allocate(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<Handle> handles;
+    handles.reserve(count);
+    while (handles.size() < count && !free_slots.empty()) {
+        handles.push_back(free_slots.back());
+        free_slots.pop_back();
+    }
+    while (handles.size() < count) {
+        if (states.size() == chunks.size() * chunk_size) {
+            if (states.size() + chunk_size > neat::no_genome_handle) {
+                throw std::runtime_error("GenomePool: nombre maximal de génomes atteint.");
+            }
+            chunks.push_back(std::make_unique<Genome[]>(chunk_size));
+        }
+        handles.push_back(static_cast<Handle>(states.size()));
+        states.push_back(SlotState::Free);
+        pins.push_back(0);
+    }
+    for (Handle handle : handles) {
+        states[handle] = SlotState::Reserved;
+        pending.push_back(handle);
+    }
+    return handles;
+}
+
+Genome &GenomePool::operator[](Handle handle) {
+    return chunks[handle / chunk_size][handle % chunk_size];
+}
+
+const Genome &GenomePool::operator[](Handle handle) const {
+    return chunks[handle / chunk_size][handle % chunk_size];
+}
+
+std::shared_ptr<Genome> GenomePool::view(Handle handle) {
+    // Constructeur d'aliasing sans propriétaire : pas de bloc de contrôle, pas de compteur
+    return std::shared_ptr<Genome>(std::shared_ptr<Genome>(), &(*this)[handle]);
+}
+
+void GenomePool::set_generation(std::vector<Handle> handles) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Handle handle : generation) {
+        states[handle] = SlotState::Retired;
+    }
+    for (Handle handle : pending) {
+        if (states[handle] == SlotState::Reserved) {
+            states[handle] = SlotState::Retired;
+        }
+    }
+    for (Handle handle : handles) {
+        if (handle != neat::no_genome_handle) {
+            states.at(handle) = SlotState::Live;
+        }
+    }
+    for (Handle handle : generation) {
+        release_if_unused(handle);
+    }
+    for (Handle handle : pending) {
+        release_if_unused(handle);
+    }
+    pending.clear();
+    generation = std::move(handles);
+}
+
+void GenomePool::pin(Handle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (states.at(handle) == SlotState::Free) {
+        throw std::runtime_error("GenomePool: impossible d'épingler un slot libre.");
+    }
+    ++pins[handle];
+}
+
+void GenomePool::unpin(Handle handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (pins.at(handle) == 0) {
+        throw std::runtime_error("GenomePool: slot non épinglé.");
+    }
+    --pins[handle];
+    release_if_unused(handle);
+}
+
+void GenomePool::release_if_unused(Handle handle) {
+    if (states[handle] == SlotState::Retired && pins[handle] == 0) {
+        states[handle] = SlotState::Free;
+        free_slots.push_back(handle);
+    }
+}
+
+GenomePool::Stats GenomePool::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats stats;
+    stats.slots = states.size();
+    stats.free = free_slots.size();
+    for (std::size_t handle = 0; handle < states.size(); ++handle) {
+        stats.live += states[handle] == SlotState::Live;
+        stats.pinned += pins[handle] > 0;
+    }
+    return stats;
+}
+
+void GenomePool::Stats::print(std::ostream &out) const {
+    out << "Pool de génomes : " << slots << " slots, " << live << " dans la génération, "
+        << pinned << " épinglés, " << free << " libres" << std::endl;
+}
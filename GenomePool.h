@@ -0,0 +1,108 @@
+#ifndef GENOME_POOL_H
+#define GENOME_POOL_H
+
+#include "neat.h"
+#include "Genome.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Pool des génomes de la population, référencés par indice.
+ *
+ * Les génomes sont rangés dans des blocs contigus de taille fixe : leur adresse ne change pas quand
+ * le pool grandit. Un individu désigne son génome par un indice (neat::GenomeHandle) et par un
+ * std::shared_ptr sans propriété (voir `view`), dont les copies ne touchent à aucun compteur de références.
+ *
+ * Un slot est libéré quand il n'appartient plus à la génération courante (voir `set_generation`) et
+ * n'est pas épinglé ; il est réutilisé pour un génome des générations suivantes. `pin` garde un génome
+ * (un champion, un génome en attente de sauvegarde...) d'une génération à l'autre.
+ */
+class GenomePool
+{
+public:
+    using Handle = neat::GenomeHandle;
+
+    // État des slots
+    struct Stats
+    {
+        std::size_t slots = 0;  // Slots créés
+        std::size_t live = 0;   // Génomes de la génération courante
+        std::size_t pinned = 0; // Slots épinglés
+        std::size_t free = 0;   // Slots libres
+
+        void print(std::ostream &out) const;
+    };
+
+    GenomePool() = default;
+
+    GenomePool(const GenomePool &) = delete;
+    GenomePool &operator=(const GenomePool &) = delete;
+
+    /**
+     * @brief Réserve des slots pour de nouveaux génomes, en réutilisant d'abord les slots libres.
+     *
+     * Les slots peuvent ensuite être remplis en parallèle, chacun par un seul thread. Un slot réservé qui
+     * n'entre pas dans la génération suivante est libéré par `set_generation`.
+     *
+     * @param count Le nombre de slots.
+     * @return std::vector<Handle> Les indices des slots réservés.
+     */
+    std::vector<Handle> allocate(std::size_t count);
+
+    Genome &operator[](Handle handle);
+    const Genome &operator[](Handle handle) const;
+
+    /**
+     * @brief Retourne un pointeur sans propriété vers un génome du pool.
+     *
+     * Le pointeur n'est valide que tant que le slot n'est pas libéré ; `pin` le garde au-delà.
+     */
+    std::shared_ptr<Genome> view(Handle handle);
+
+    /**
+     * @brief Déclare les génomes de la nouvelle génération.
+     *
+     * Les slots de l'ancienne génération et les slots réservés depuis qui n'en font pas partie, et qui ne
+     * sont pas épinglés, sont libérés.
+     *
+     * @param handles Les indices des génomes de la génération.
+     */
+    void set_generation(std::vector<Handle> handles);
+
+    /**
+     * @brief Épingle un génome : son slot n'est pas libéré avant l'appel correspondant à `unpin`.
+     *
+     * `pin` et `unpin` peuvent être appelés depuis n'importe quel thread.
+     */
+    void pin(Handle handle);
+    void unpin(Handle handle);
+
+    Stats get_stats() const;
+
+private:
+    static constexpr std::size_t chunk_size = 1024;
+
+    enum class SlotState : char
+    {
+        Free,
+        Reserved, // Réservé par `allocate`, pas encore dans une génération
+        Live,     // Dans la génération courante
+        Retired   // Hors de la génération courante, gardé par un épinglage
+    };
+
+    void release_if_unused(Handle handle); // Appelée verrou pris
+
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<Genome[]>> chunks;
+    std::vector<SlotState> states;
+    std::vector<std::uint32_t> pins;  // Nombre d'épinglages par slot
+    std::vector<Handle> generation;   // Slots de la génération courante
+    std::vector<Handle> pending;      // Slots réservés depuis le dernier `set_generation`
+    std::vector<Handle> free_slots;
+};
+
+#endif // GENOME_POOL_H
@@ -0,0 +1,84 @@
+#include "GenomeWriter.h"
+#include "Utils.h"
+#include <algorithm>
+
+GenomeWriter::GenomeWriter()
+    : period_start(std::chrono::steady_clock::now()), thread(&GenomeWriter::run, this) {}
+
+GenomeWriter::~GenomeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    thread.join();
+}
+
+void GenomeWriter::save(std::shared_ptr<const Genome> genome, std::string filename) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.emplace_back(std::move(genome), std::move(filename));
+        stats.max_queued = std::max(stats.max_queued, queue.size());
+    }
+    wake.notify_one();
+}
+
+void GenomeWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return queue.empty() && !writing; });
+}
+
+GenomeWriter::Stats GenomeWriter::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats current = stats;
+    current.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - period_start).count();
+    return current;
+}
+
+void GenomeWriter::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats = Stats{};
+    stats.max_queued = queue.size();
+    period_start = std::chrono::steady_clock::now();
+}
+
+void GenomeWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return; // Arrêt demandé et tout est écrit
+        }
+
+        auto job = std::move(queue.front());
+        queue.pop_front();
+        writing = true;
+        lock.unlock();
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool written = write_genome(*job.first, job.second);
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        writing = false;
+        if (written) {
+            ++stats.written;
+        } else {
+            ++stats.failed;
+        }
+        stats.busy_seconds += elapsed;
+        if (queue.empty()) {
+            idle.notify_all();
+        }
+    }
+}
+
+double GenomeWriter::Stats::occupancy() const {
+    return seconds > 0.0 ? busy_seconds / seconds : 0.0;
+}
+
+void GenomeWriter::Stats::print(std::ostream &out) const {
+    out << "Écriture des génomes : " << written << " fichiers en " << busy_seconds * 1000.0 << " ms"
+        << (failed > 0 ? ", " + std::to_string(failed) + " échecs" : std::string())
+        << " (occupation " << occupancy() * 100.0 << " %, file max " << max_queued << ")" << std::endl;
+}
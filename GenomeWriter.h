@@ -0,0 +1,80 @@
+#ifndef GENOME_WRITER_H
+#define GENOME_WRITER_H
+
+#include "Genome.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Sauvegarde des génomes sur un thread dédié.
+ *
+ * `save` met la sauvegarde en file et rend la main aussitôt : l'écriture des fichiers (voir
+ * ::write_genome) se fait pendant que la boucle d'évolution continue. Le thread d'écriture n'affiche
+ * rien ; les fichiers qui n'ont pas pu être écrits sont comptés dans les statistiques. Les génomes ne sont plus modifiés une fois
+ * créés ; la file garde un pointeur partagé sur chacun jusqu'à son écriture.
+ */
+class GenomeWriter
+{
+public:
+    // Statistiques depuis le dernier `reset_stats`
+    struct Stats
+    {
+        std::size_t written = 0;
+        std::size_t failed = 0;     // Fichiers qui n'ont pas pu être ouverts ou écrits
+        std::size_t max_queued = 0; // Plus longue file d'attente observée
+        double busy_seconds = 0.0;  // Temps passé à écrire
+        double seconds = 0.0;       // Durée de la période observée
+
+        double occupancy() const;   // Fraction du temps passée à écrire
+        void print(std::ostream &out) const;
+    };
+
+    GenomeWriter();
+
+    /**
+     * @brief Écrit les sauvegardes encore en file puis arrête le thread.
+     */
+    ~GenomeWriter();
+
+    GenomeWriter(const GenomeWriter &) = delete;
+    GenomeWriter &operator=(const GenomeWriter &) = delete;
+
+    /**
+     * @brief Met en file la sauvegarde d'un génome.
+     *
+     * @param genome Le génome à sauvegarder.
+     * @param filename Le chemin du fichier.
+     */
+    void save(std::shared_ptr<const Genome> genome, std::string filename);
+
+    /**
+     * @brief Attend que toutes les sauvegardes en file soient écrites.
+     */
+    void flush();
+
+    Stats get_stats() const;
+    void reset_stats();
+
+private:
+    void run();
+
+    mutable std::mutex mutex;
+    std::condition_variable wake; // Réveille le thread d'écriture
+    std::condition_variable idle; // Signale une file vide
+    std::deque<std::pair<std::shared_ptr<const Genome>, std::string>> queue;
+    bool writing = false;
+    bool stopping = false;
+    Stats stats;
+    std::chrono::steady_clock::time_point period_start;
+    std::thread thread;
+};
+
+#endif // GENOME_WRITER_H
@@ -0,0 +1,131 @@
+#include "GroupedEvaluator.h"
+#include "NeuralNetwork.h"
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+
+GroupedEvaluator::GroupedEvaluator(std::vector<double> inputs, std::size_t num_samples, ScoreFunction score)
+    : m_inputs(std::move(inputs)), m_num_samples(num_samples), m_score(std::move(score)) {}
+
+double GroupedEvaluator::evaluate_single(const Genome &genome)
+{
+    FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(genome);
+    std::vector<double> outputs = network.activate_batch(m_inputs, m_num_samples);
+    return m_score(outputs.data(), m_num_samples, network.num_outputs());
+}
+
+std::vector<double> GroupedEvaluator::evaluate(const std::vector<neat::Individual> &individuals, bool measure_speedup)
+{
+    using Clock = std::chrono::steady_clock;
+
+    m_stats = Stats{};
+    m_stats.num_individuals = individuals.size();
+
+    // Regroupe les individus par empreinte structurelle, dans l'ordre de première apparition
+    std::vector<std::vector<std::size_t>> groups;
+    std::unordered_map<std::size_t, std::size_t> group_by_hash;
+    for (std::size_t i = 0; i < individuals.size(); i++)
+    {
+        std::size_t hash = individuals[i].genome->structural_hash();
+        auto it = group_by_hash.find(hash);
+        if (it == group_by_hash.end())
+        {
+            group_by_hash.emplace(hash, groups.size());
+            groups.push_back({i});
+        }
+        else
+        {
+            groups[it->second].push_back(i);
+        }
+    }
+
+    std::vector<double> scores(individuals.size(), 0.0);
+    std::vector<double> outputs;
+    Clock::duration batched_time{};
+
+    for (const auto &group : groups)
+    {
+        const Genome &representative = *individuals[group.front()].genome;
+
+        if (measure_speedup)
+        {
+            auto start = Clock::now();
+            evaluate_single(representative);
+            m_stats.estimated_serial_seconds += std::chrono::duration<double>(Clock::now() - start).count() * group.size();
+        }
+
+        auto start = Clock::now();
+        FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(representative);
+
+        std::vector<const Genome *> batch;
+        std::vector<std::size_t> batch_indices;
+        for (std::size_t index : group)
+        {
+            const Genome &genome = *individuals[index].genome;
+            if (network.matches_structure(genome))
+            {
+                batch.push_back(&genome);
+                batch_indices.push_back(index);
+            }
+            else
+            {
+                // Collision d'empreinte : évaluation isolée
+                scores[index] = evaluate_single(genome);
+                ++m_stats.fallback_individuals;
+            }
+        }
+
+        if (!batch.empty())
+        {
+            network.activate_columns(batch, m_inputs, m_num_samples, outputs);
+            const std::size_t stride = m_num_samples * network.num_outputs();
+            for (std::size_t g = 0; g < batch.size(); g++)
+            {
+                scores[batch_indices[g]] = m_score(outputs.data() + g * stride, m_num_samples, network.num_outputs());
+            }
+        }
+        batched_time += Clock::now() - start;
+
+        m_stats.group_sizes.push_back(group.size());
+        m_stats.largest_group = std::max(m_stats.largest_group, group.size());
+    }
+
+    m_stats.num_groups = groups.size();
+    m_stats.seconds = std::chrono::duration<double>(batched_time).count();
+    return scores;
+}
+
+const GroupedEvaluator::Stats &GroupedEvaluator::get_stats() const
+{
+    return m_stats;
+}
+
+double GroupedEvaluator::Stats::mean_group_size() const
+{
+    return num_groups == 0 ? 0.0 : static_cast<double>(num_individuals) / num_groups;
+}
+
+double GroupedEvaluator::Stats::speedup() const
+{
+    return seconds > 0.0 && estimated_serial_seconds > 0.0 ? estimated_serial_seconds / seconds : 0.0;
+}
+
+void GroupedEvaluator::Stats::print(std::ostream &out) const
+{
+    out << "Évaluation groupée : " << num_individuals << " individus, " << num_groups << " topologies"
+        << " (taille moyenne " << mean_group_size() << ", max " << largest_group
+        << ", isolés " << fallback_individuals << ")" << std::endl;
+    out << "  Tailles des groupes :";
+    for (std::size_t size : group_sizes)
+    {
+        out << " " << size;
+    }
+    out << std::endl;
+    out << "  Durée : " << seconds * 1000.0 << " ms";
+    if (estimated_serial_seconds > 0.0)
+    {
+        out << ", estimée génome par génome : " << estimated_serial_seconds * 1000.0 << " ms"
+            << " (accélération x" << speedup() << ")";
+    }
+    out << std::endl;
+}
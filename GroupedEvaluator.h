@@ -0,0 +1,70 @@
+#ifndef GROUPED_EVALUATOR_H
+#define GROUPED_EVALUATOR_H
+
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include "neat.h"
+#include "Genome.h"
+
+class GroupedEvaluator
+{
+public:
+    // Statistiques de la dernière évaluation groupée
+    struct Stats
+    {
+        std::size_t num_individuals = 0;
+        std::size_t num_groups = 0;           // Nombre de passages sur une topologie
+        std::size_t largest_group = 0;
+        std::size_t fallback_individuals = 0; // Évalués seuls (empreinte identique mais structure différente)
+        std::vector<std::size_t> group_sizes;
+        double seconds = 0.0;                  // Durée de l'évaluation groupée
+        double estimated_serial_seconds = 0.0; // Durée estimée génome par génome (0 si non mesurée)
+
+        double mean_group_size() const;
+        double speedup() const;
+        void print(std::ostream &out) const;
+    };
+
+    /**
+     * @brief Fonction de score appliquée aux sorties d'un génome.
+     *
+     * Reçoit les sorties N×num_outputs (une ligne par échantillon) et retourne la fitness du génome.
+     */
+    using ScoreFunction = std::function<double(const double *outputs, std::size_t num_samples, std::size_t num_outputs)>;
+
+    /**
+     * @brief Construit un évaluateur qui soumet les mêmes entrées à tous les génomes.
+     *
+     * @param inputs Vecteur N×num_inputs des entrées, une ligne par échantillon.
+     * @param num_samples Le nombre d'échantillons N.
+     * @param score La fonction qui transforme les sorties d'un génome en fitness.
+     */
+    GroupedEvaluator(std::vector<double> inputs, std::size_t num_samples, ScoreFunction score);
+
+    /**
+     * @brief Évalue une population en regroupant les individus de même structure.
+     *
+     * Les individus sont regroupés par `Genome::structural_hash`. Chaque groupe est compilé une seule fois
+     * et évalué en un seul passage, les poids de chaque génome formant une colonne du programme.
+     *
+     * @param individuals Les individus à évaluer.
+     * @param measure_speedup Si vrai, mesure aussi le coût d'une évaluation génome par génome du représentant
+     *                        de chaque groupe pour estimer l'accélération.
+     * @return std::vector<double> Les fitness, dans l'ordre des individus.
+     */
+    std::vector<double> evaluate(const std::vector<neat::Individual> &individuals, bool measure_speedup = false);
+
+    const Stats &get_stats() const;
+
+private:
+    double evaluate_single(const Genome &genome);
+
+    std::vector<double> m_inputs;
+    std::size_t m_num_samples;
+    ScoreFunction m_score;
+    Stats m_stats;
+};
+
+#endif // GROUPED_EVALUATOR_H
@@ -0,0 +1,164 @@
+#include "InnovationTracker.h"
+#include "Genome.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Les gènes compacts rangent les deux neurones d'un lien dans un seul mot (voir neat::GeneEncoding) :
+    // un identifiant hors de leur plage est refusé dès son attribution, et non à l'ajout du lien
+    void check_neuron_id(int neuron_id) {
+        if (neuron_id > neat::max_neuron_id) {
+            throw std::runtime_error("InnovationTracker : plus d'identifiant de neurone disponible pour le codage des gènes "
+                                     "(NEAT_COMPACT_GENES limite les identifiants à " + std::to_string(neat::max_neuron_id) + ").");
+        }
+    }
+}
+
+InnovationTracker::InnovationTracker(int first_neuron_id)
+    : next_innovation(0), next_neuron_id(first_neuron_id) {}
+
+InnovationTracker::InnovationTracker(InnovationTracker &committed, Snapshot snapshot)
+    : next_innovation(snapshot.next_innovation), next_neuron_id(snapshot.next_neuron_id),
+      committed(&committed), base(snapshot) {}
+
+InnovationTracker::Snapshot InnovationTracker::snapshot() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return Snapshot{next_innovation, next_neuron_id};
+}
+
+// Les numéros sont attribués par ordre croissant : ceux de `base` et au-delà ont été enregistrés après lui
+bool InnovationTracker::find_committed_link(neat::LinkId link_id, int &innovation) {
+    std::lock_guard<std::mutex> lock(committed->mutex);
+    auto it = committed->link_innovations.find(link_id);
+    if (it == committed->link_innovations.end() || it->second >= base.next_innovation) {
+        return false;
+    }
+    innovation = it->second;
+    return true;
+}
+
+bool InnovationTracker::find_committed_split(neat::LinkId split_link, int &neuron_id) {
+    std::lock_guard<std::mutex> lock(committed->mutex);
+    auto it = committed->split_neurons.find(split_link);
+    if (it == committed->split_neurons.end() || it->second >= base.next_neuron_id) {
+        return false;
+    }
+    neuron_id = it->second;
+    return true;
+}
+
+int InnovationTracker::link_innovation(neat::LinkId link_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = link_innovations.find(link_id);
+    if (it != link_innovations.end()) {
+        return it->second;
+    }
+    int innovation;
+    if (committed && find_committed_link(link_id, innovation)) {
+        return innovation;
+    }
+    if (committed) {
+        new_links.push_back(link_id);
+    }
+    link_innovations.emplace(link_id, next_innovation);
+    return next_innovation++;
+}
+
+int InnovationTracker::split_neuron_id(neat::LinkId split_link) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = split_neurons.find(split_link);
+    if (it != split_neurons.end()) {
+        return it->second;
+    }
+    int neuron_id;
+    if (committed && find_committed_split(split_link, neuron_id)) {
+        return neuron_id;
+    }
+    check_neuron_id(next_neuron_id);
+    neuron_id = next_neuron_id++;
+    if (committed) {
+        new_neurons.push_back(NewNeuron{neuron_id, true, split_link});
+    }
+    split_neurons.emplace(split_link, neuron_id);
+    return neuron_id;
+}
+
+int InnovationTracker::new_neuron_id() {
+    std::lock_guard<std::mutex> lock(mutex);
+    check_neuron_id(next_neuron_id);
+    if (committed) {
+        new_neurons.push_back(NewNeuron{next_neuron_id, false, neat::LinkId{}});
+    }
+    return next_neuron_id++;
+}
+
+void InnovationTracker::register_neuron_id(int neuron_id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    check_neuron_id(neuron_id);
+    next_neuron_id = std::max(next_neuron_id, neuron_id + 1);
+}
+
+InnovationTracker::Renumbering InnovationTracker::commit(const InnovationTracker &draft) {
+    Renumbering renumbering;
+    auto final_link = [&](neat::LinkId link_id) {
+        for (int *endpoint : {&link_id.input_id, &link_id.output_id}) {
+            auto it = renumbering.neuron_ids.find(*endpoint);
+            if (it != renumbering.neuron_ids.end()) {
+                *endpoint = it->second;
+            }
+        }
+        return link_id;
+    };
+    // Un lien divisé peut relier des neurones créés plus tôt par le même descendant : les neurones sont
+    // renumérotés dans l'ordre de leur création
+    for (const NewNeuron &neuron : draft.new_neurons) {
+        renumbering.neuron_ids.emplace(neuron.neuron_id,
+            neuron.is_split ? split_neuron_id(final_link(neuron.split_link)) : new_neuron_id());
+    }
+    for (const neat::LinkId &link_id : draft.new_links) {
+        renumbering.innovations.emplace(draft.link_innovations.at(link_id), link_innovation(final_link(link_id)));
+    }
+    return renumbering;
+}
+
+bool InnovationTracker::Renumbering::empty() const {
+    return neuron_ids.empty() && innovations.empty();
+}
+
+Genome InnovationTracker::Renumbering::apply(const Genome &genome) const {
+    auto renumber = [](const std::unordered_map<int, int> &numbers, int number) {
+        auto it = numbers.find(number);
+        return it != numbers.end() ? it->second : number;
+    };
+
+    std::vector<neat::NeuronGene> neurons;
+    neurons.reserve(genome.get_neurons().size());
+    for (const auto &neuron : genome.get_neurons()) {
+        neurons.push_back(neat::NeuronGene(neuron));
+        neurons.back().neuron_id = renumber(neuron_ids, neurons.back().neuron_id);
+    }
+    std::vector<neat::LinkGene> links;
+    links.reserve(genome.get_links().size());
+    for (const auto &link : genome.get_links()) {
+        links.push_back(neat::LinkGene(link));
+        neat::LinkGene &renumbered = links.back();
+        renumbered.link_id.input_id = renumber(neuron_ids, renumbered.link_id.input_id);
+        renumbered.link_id.output_id = renumber(neuron_ids, renumbered.link_id.output_id);
+        renumbered.innovation = renumber(innovations, renumbered.innovation);
+    }
+    std::sort(neurons.begin(), neurons.end(),
+        [](const neat::NeuronGene &a, const neat::NeuronGene &b) { return a.neuron_id < b.neuron_id; });
+    std::sort(links.begin(), links.end(),
+        [](const neat::LinkGene &a, const neat::LinkGene &b) { return a.innovation < b.innovation; });
+
+    Genome renumbered(genome.get_genome_id(), genome.get_num_inputs(), genome.get_num_outputs());
+    renumbered.reserve(neurons.size(), links.size());
+    for (const neat::NeuronGene &neuron : neurons) {
+        renumbered.add_neuron(neuron);
+    }
+    for (const neat::LinkGene &link : links) {
+        renumbered.add_link(link);
+    }
+    return renumbered;
+}
@@ -0,0 +1,148 @@
+#ifndef INNOVATION_TRACKER_H
+#define INNOVATION_TRACKER_H
+
+#include "neat.h"
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+class Genome;
+
+/**
+ * @brief Attribue des numéros d'innovation partagés par toute la population.
+ *
+ * Une même connexion (même neurone d'entrée, même neurone de sortie) reçoit le même numéro
+ * d'innovation dans tous les génomes, et la division d'un même lien produit le même neurone caché.
+ * Les gènes de deux parents peuvent ainsi être alignés par simple fusion de listes triées.
+ *
+ * Les méthodes sont protégées par un verrou : le registre peut être partagé par les threads
+ * qui produisent une génération en parallèle.
+ *
+ * Pour que les numéros ne dépendent pas de l'ordre d'exécution des threads, chaque descendant
+ * d'une génération parallèle est muté sous un registre provisoire (voir le constructeur
+ * `InnovationTracker(InnovationTracker &, Snapshot)`), dont les innovations sont ensuite
+ * numérotées par `commit`, en série et dans l'ordre des descendants.
+ */
+class InnovationTracker
+{
+public:
+    // Prochains numéros libres d'un registre : les numéros inférieurs sont déjà attribués
+    struct Snapshot
+    {
+        int next_innovation;
+        int next_neuron_id;
+    };
+
+    // Numéros définitifs des gènes créés sous un registre provisoire (voir `commit`)
+    struct Renumbering
+    {
+        std::unordered_map<int, int> neuron_ids;  // Identifiant provisoire -> identifiant définitif
+        std::unordered_map<int, int> innovations; // Numéro provisoire -> numéro définitif
+
+        bool empty() const;
+
+        /**
+         * @brief Retourne une copie du génome dont les gènes provisoires portent leurs numéros définitifs.
+         */
+        Genome apply(const Genome &genome) const;
+    };
+
+    /**
+     * @brief Construit un nouvel objet InnovationTracker.
+     *
+     * @param first_neuron_id Le premier identifiant disponible pour les neurones créés par mutation.
+     */
+    explicit InnovationTracker(int first_neuron_id = 0);
+
+    /**
+     * @brief Construit un registre provisoire au-dessus de `committed`.
+     *
+     * Les innovations attribuées par `committed` avant `snapshot` sont retournées telles quelles ;
+     * les autres reçoivent des numéros provisoires, à partir de ceux de `snapshot`, sans modifier
+     * `committed`. Le résultat ne dépend donc pas de ce que d'autres threads enregistrent entre-temps.
+     *
+     * @param committed Le registre de la population.
+     * @param snapshot L'état de `committed` au début de la génération.
+     */
+    InnovationTracker(InnovationTracker &committed, Snapshot snapshot);
+
+    /**
+     * @brief Retourne les prochains numéros libres.
+     */
+    Snapshot snapshot();
+
+    /**
+     * @brief Attribue leurs numéros définitifs aux innovations d'un registre provisoire.
+     *
+     * Les neurones puis les liens sont enregistrés dans l'ordre où le registre provisoire les a créés :
+     * appelé en série dans un ordre fixe, `commit` numérote de la même façon à chaque exécution.
+     *
+     * @param draft Un registre provisoire construit au-dessus de ce registre.
+     * @return Renumbering Les numéros à appliquer au génome muté sous `draft`.
+     */
+    Renumbering commit(const InnovationTracker &draft);
+
+    /**
+     * @brief Retourne le numéro d'innovation d'une connexion, en l'attribuant si elle est nouvelle.
+     *
+     * @param link_id La connexion.
+     * @return int Le numéro d'innovation de la connexion.
+     */
+    int link_innovation(neat::LinkId link_id);
+
+    /**
+     * @brief Retourne l'identifiant du neurone obtenu en divisant un lien.
+     *
+     * Tous les génomes qui divisent le même lien obtiennent le même neurone, dont l'identifiant
+     * sert aussi de numéro d'innovation.
+     *
+     * @param split_link Le lien divisé.
+     * @return int L'identifiant du neurone caché.
+     * @throws std::runtime_error Si l'identifiant dépasse neat::max_neuron_id (codage compact des gènes).
+     */
+    int split_neuron_id(neat::LinkId split_link);
+
+    /**
+     * @brief Retourne un identifiant de neurone jamais attribué.
+     *
+     * Utilisé lorsque le neurone associé à la division d'un lien est déjà présent dans le génome.
+     *
+     * @throws std::runtime_error Si l'identifiant dépasse neat::max_neuron_id (codage compact des gènes).
+     */
+    int new_neuron_id();
+
+    /**
+     * @brief Signale un identifiant de neurone déjà utilisé (par exemple à la création d'un génome).
+     *
+     * Les identifiants attribués ensuite lui seront strictement supérieurs.
+     *
+     * @param neuron_id L'identifiant utilisé.
+     */
+    void register_neuron_id(int neuron_id);
+
+private:
+    // Neurone créé sous un registre provisoire : division de `split_link`, ou identifiant neuf
+    struct NewNeuron
+    {
+        int neuron_id;
+        bool is_split;
+        neat::LinkId split_link;
+    };
+
+    std::mutex mutex;
+    int next_innovation;
+    int next_neuron_id;
+    std::unordered_map<neat::LinkId, int, neat::LinkIdHash> link_innovations;
+    std::unordered_map<neat::LinkId, int, neat::LinkIdHash> split_neurons;
+
+    // Registre provisoire uniquement : registre de la population, son état initial et les créations dans l'ordre
+    InnovationTracker *committed = nullptr;
+    Snapshot base{0, 0};
+    std::vector<NewNeuron> new_neurons;
+    std::vector<neat::LinkId> new_links;
+
+    bool find_committed_link(neat::LinkId link_id, int &innovation);
+    bool find_committed_split(neat::LinkId split_link, int &neuron_id);
+};
+
+#endif // INNOVATION_TRACKER_H
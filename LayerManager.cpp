@@ -1,92 +1,155 @@
 #include "LayerManager.h"
 #include <unordered_map>
 #include <algorithm>
+#include <stdexcept>
 
-std::vector<std::vector<int>> LayerManager::organize_layers(
+LayerManager::Layering LayerManager::compute_layering(
     const std::vector<int> &inputs,
     const std::vector<int> &outputs,
-    const std::vector<neat::LinkGene> &links)
+    const neat::LinkGenes &links)
 {
+    // Index dense pour chaque neurone rencontré
+    std::unordered_map<int, int> index_of;
+    std::vector<int> ids;
+    auto index = [&](int neuron_id)
+    {
+        auto it = index_of.find(neuron_id);
+        if (it != index_of.end())
+        {
+            return it->second;
+        }
+        int new_index = static_cast<int>(ids.size());
+        index_of.emplace(neuron_id, new_index);
+        ids.push_back(neuron_id);
+        return new_index;
+    };
 
-    std::unordered_set<int> known_neurons(inputs.begin(), inputs.end());
-    std::unordered_set<int> output_neurons(outputs.begin(), outputs.end());
-    std::vector<std::vector<int>> layers;
+    for (int input : inputs)
+    {
+        index(input);
+    }
+    for (int output : outputs)
+    {
+        index(output);
+    }
+
+    // Listes d'adjacence et degrés entrants, en un seul passage sur les liens
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(links.size());
+    for (const auto &link : links)
+    {
+        edges.emplace_back(index(link.link_id.input_id), index(link.link_id.output_id));
+    }
+
+    const std::size_t num_neurons = ids.size();
+    std::vector<std::vector<int>> successors(num_neurons);
+    std::vector<int> in_degree(num_neurons, 0);
+    for (const auto &edge : edges)
+    {
+        successors[edge.first].push_back(edge.second);
+        ++in_degree[edge.second];
+    }
 
-    layers.push_back(inputs);
+    std::vector<char> is_input(num_neurons, 0);
+    for (int input : inputs)
+    {
+        is_input[index_of[input]] = 1;
+    }
+    std::vector<char> is_output(num_neurons, 0);
+    for (int output : outputs)
+    {
+        is_output[index_of[output]] = 1;
+    }
 
-    bool added_new_layer = true;
-    while (added_new_layer)
+    // Tri topologique de Kahn ; la profondeur est le plus long chemin depuis une entrée
+    std::vector<int> depth(num_neurons, 0);
+    std::vector<int> queue;
+    queue.reserve(num_neurons);
+    for (std::size_t n = 0; n < num_neurons; n++)
     {
-        added_new_layer = false;
-        std::vector<int> new_layer;
+        if (in_degree[n] == 0)
+        {
+            queue.push_back(static_cast<int>(n));
+            depth[n] = is_input[n] ? 0 : 1;
+        }
+    }
 
-        for (const auto &link : links)
+    for (std::size_t head = 0; head < queue.size(); head++)
+    {
+        int current = queue[head];
+        for (int next : successors[current])
         {
-            if (known_neurons.count(link.link_id.input_id) &&
-                !known_neurons.count(link.link_id.output_id) &&
-                !output_neurons.count(link.link_id.output_id))
+            depth[next] = std::max(depth[next], depth[current] + 1);
+            if (--in_degree[next] == 0)
             {
-
-                new_layer.push_back(link.link_id.output_id);
-                known_neurons.insert(link.link_id.output_id);
-                added_new_layer = true;
+                queue.push_back(next);
             }
         }
+    }
+
+    // Vérification : un neurone jamais extrait de la file appartient à un cycle
+    if (queue.size() != num_neurons)
+    {
+        throw std::runtime_error("LayerManager: cycle detected in links.");
+    }
 
-        if (!new_layer.empty())
+    Layering layering;
+    layering.depth.reserve(num_neurons);
+    int max_depth = 0;
+    for (std::size_t n = 0; n < num_neurons; n++)
+    {
+        if (is_input[n])
         {
-            layers.push_back(new_layer);
+            depth[n] = 0;
         }
-        // Vérification : détecte un cycle potentiel
-        if (layers.size() > links.size() + inputs.size() + outputs.size())
+        layering.depth.emplace(ids[n], depth[n]);
+        if (!is_input[n] && !is_output[n])
         {
-            throw std::runtime_error("LayerManager: Too many layers detected, possible cycle in links.");
+            max_depth = std::max(max_depth, depth[n]);
         }
     }
 
-    layers.push_back(outputs);
-    return layers;
-}
-
-std::vector<int> LayerManager::sort_by_layer(
-    const std::vector<int> &layer,
-    const std::vector<neat::LinkGene> &links)
-{
+    layering.layers.push_back(inputs);
 
-    std::unordered_map<int, int> neuron_layers;
-    for (int neuron : layer)
+    std::vector<std::vector<int>> hidden_layers(max_depth + 1);
+    for (int n : queue)
     {
-        neuron_layers[neuron] = 0;
+        if (!is_input[n] && !is_output[n])
+        {
+            hidden_layers[depth[n]].push_back(ids[n]);
+        }
     }
-
-    bool changed = true;
-    while (changed)
+    for (auto &layer : hidden_layers)
     {
-        changed = false;
-
-        for (const auto &link : links)
+        if (!layer.empty())
         {
-            int input_neuron = link.link_id.input_id;
-            int output_neuron = link.link_id.output_id;
-
-            if (neuron_layers.count(input_neuron))
-            {
-                int input_layer = neuron_layers[input_neuron];
-                int expected_output_layer = input_layer + 1;
-
-                if (!neuron_layers.count(output_neuron) || neuron_layers[output_neuron] < expected_output_layer)
-                {
-                    neuron_layers[output_neuron] = expected_output_layer;
-                    changed = true;
-                }
-            }
+            layering.layers.push_back(std::move(layer));
         }
     }
 
+    layering.layers.push_back(outputs);
+    return layering;
+}
+
+std::vector<std::vector<int>> LayerManager::organize_layers(
+    const std::vector<int> &inputs,
+    const std::vector<int> &outputs,
+    const neat::LinkGenes &links)
+{
+    return compute_layering(inputs, outputs, links).layers;
+}
+
+std::vector<int> LayerManager::sort_by_layer(
+    const std::vector<int> &layer,
+    const neat::LinkGenes &links)
+{
+    // Profondeur de chaque neurone dans le graphe complet des liens
+    Layering layering = compute_layering({}, {}, links);
+
     std::vector<int> sorted_layer = layer;
-    std::sort(sorted_layer.begin(), sorted_layer.end(),
-              [&](int a, int b)
-              { return neuron_layers[a] < neuron_layers[b]; });
+    std::stable_sort(sorted_layer.begin(), sorted_layer.end(),
+                     [&](int a, int b)
+                     { return layering.depth[a] < layering.depth[b]; });
 
     return sorted_layer;
 }
@@ -4,17 +4,49 @@
 
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include "neat.h"
+#include "GeneColumns.h"
 
 class LayerManager
 {
 public:
+    /**
+     * @brief Résultat du tri topologique : couches et profondeur de chaque neurone.
+     */
+    struct Layering
+    {
+        std::vector<std::vector<int>> layers;  // Couches dans l'ordre d'évaluation
+        std::unordered_map<int, int> depth;    // Profondeur (plus long chemin depuis une entrée) de chaque neurone
+    };
+
+    /**
+     * @brief Calcule les couches et les profondeurs en un seul tri topologique (algorithme de Kahn).
+     *
+     * Les listes d'adjacence et les degrés entrants sont construits en un seul passage sur les liens,
+     * puis les neurones sont extraits d'une file dès que tous leurs prédécesseurs ont été traités,
+     * soit un coût en O(V + E). Les entrées forment la couche 0, les neurones cachés sont regroupés
+     * par profondeur et les sorties forment la dernière couche.
+     *
+     * @param inputs Un vecteur d'entiers représentant les ID des neurones d'entrée.
+     * @param outputs Un vecteur d'entiers représentant les ID des neurones de sortie.
+     * @param links Un vecteur de neat::LinkGene représentant les liens entre les neurones.
+     *
+     * @return Layering Les couches et la profondeur de chaque neurone.
+     *
+     * @throws std::runtime_error Si les liens contiennent un cycle.
+     */
+    static Layering compute_layering(
+        const std::vector<int> &inputs,
+        const std::vector<int> &outputs,
+        const neat::LinkGenes &links);
+
     /**
      * @brief Identifie les couches de neurones en fonction des liens fournis.
      *
      * Cette fonction organise les neurones en couches à partir des neurones d’entrée,
-     * puis en ajoutant progressivement des couches de neurones sur la base des liens fournis,
-     * en s’assurant que les neurones d’une couche sont tous connectés aux neurones de la couche précédente.
+     * puis en regroupant les neurones cachés selon leur profondeur, de sorte que chaque
+     * neurone apparaisse après tous les neurones qui l'alimentent. Les sorties forment la dernière couche.
      *
      * @param inputs Un vecteur d'entiers représentant les ID des neurones d'entrée.
      * @param outputs Un vecteur d'entiers représentant les ID des neurones de sortie.
@@ -22,27 +54,29 @@ public:
      *
      * @return Vecteur de vecteurs d’entiers, où chaque vecteur interne représente une couche d’identificateurs neuronaux.
      *
-     * @note Cette fonction suppose que les neurones d'entrée et de sortie sont correctement connectés.
+     * @throws std::runtime_error Si les liens contiennent un cycle.
      */
     static std::vector<std::vector<int>> organize_layers(
         const std::vector<int> &inputs,
         const std::vector<int> &outputs,
-        const std::vector<neat::LinkGene> &links);
+        const neat::LinkGenes &links);
 
     /**
      * @brief Trie les neurones par couche en fonction des liens fournis.
      *
-     * Cette fonction trie les neurones par couche en fonction des liens fournis, en s’assurant que
-     * les neurones d’une couche sont tous connectés aux neurones de la couche précédente.
+     * Cette fonction trie les neurones d'une couche par profondeur croissante, la profondeur
+     * étant calculée par un tri topologique des liens fournis.
      *
      * @param layer Un vecteur d'entiers représentant les ID des neurones d'une couche.
      * @param links Un vecteur de neat::LinkGene représentant les liens entre les neurones.
      *
      * @return Vecteur d'entiers représentant les ID des neurones triés par couche.
+     *
+     * @throws std::runtime_error Si les liens contiennent un cycle.
      */
     static std::vector<int> sort_by_layer(
         const std::vector<int> &layer,
-        const std::vector<neat::LinkGene> &links);
+        const neat::LinkGenes &links);
 
 private:
 };
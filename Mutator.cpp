@@ -4,21 +4,22 @@
 #include "link_mutator.h"
 #include "RNG.h"
 #include <iostream>
+#include <algorithm>
 #include <functional>
 
 
-void Mutator::mutate(Genome &genome, const NeatConfig &config, RNG &rng) {
+void Mutator::mutate(Genome &genome, const NeatConfig &config, RNG &rng, InnovationTracker &innovations) {
     if (rng.next_double() < config.probability_add_link) {
-        mutate_add_link(genome);
+        mutate_add_link(genome, rng, innovations);
     }
     if (rng.next_double() < config.probability_remove_link) {
-        mutate_remove_link(genome);
+        mutate_remove_link(genome, rng);
     }
     if (rng.next_double() < config.probability_add_neuron) {
-        mutate_add_neuron(genome);
+        mutate_add_neuron(genome, rng, innovations);
     }
     if (rng.next_double() < config.probability_remove_neuron) {
-        mutate_remove_neuron(genome);
+        mutate_remove_neuron(genome, rng);
     }
 
     // Mutate weights and biases
@@ -29,9 +30,10 @@ void Mutator::mutate(Genome &genome, const NeatConfig &config, RNG &rng) {
     }
 }
 
-void Mutator::mutate_add_link(Genome &genome) { 
-    int input_id = choose_random_input_or_hidden_neuron(genome.get_neurons());  
-    int output_id = choose_random_output_or_hidden_neuron(genome.get_neurons());
+void Mutator::mutate_add_link(Genome &genome, RNG &rng, InnovationTracker &innovations) { 
+    const Genome &view = genome;
+    int input_id = choose_random_input_or_hidden_neuron(view.get_neurons(), rng);  
+    int output_id = choose_random_output_or_hidden_neuron(view.get_neurons(), rng);
 
     if (input_id == -1 || output_id == -1) {
         return;
@@ -39,37 +41,40 @@ void Mutator::mutate_add_link(Genome &genome) {
 
     neat::LinkId link_id{input_id, output_id};
 
-    auto existing_link = genome.find_link(link_id);
+    auto existing_link = view.find_link(link_id);
     if (existing_link) {
         if (!existing_link->is_enabled) {
-            existing_link->is_enabled = true;
+            genome.set_link_enabled(link_id, true);
         }
         return;
     }
 
-    if (would_create_cycle(genome.get_links(), input_id, output_id)) {
+    if (view.would_create_cycle(input_id, output_id)) {
         return;
     }
 
-    neat::LinkMutator link_mutator;
+    neat::LinkMutator link_mutator(rng);
     neat::LinkGene new_link = link_mutator.new_value(input_id, output_id);
+    new_link.innovation = innovations.link_innovation(link_id);
     genome.add_link(new_link);
 
 }
 
-void Mutator::mutate_remove_link(Genome &genome) {
-    RNG rng;
+void Mutator::mutate_remove_link(Genome &genome, RNG &rng) {
     NeatConfig config;
+    const Genome &view = genome;
+    const auto &neurons = view.get_neurons();
+    const auto &links = view.get_links();
 
-    if (genome.get_links().empty()) {
+    if (links.empty()) {
         return;
     }
 
     std::unordered_set<neat::LinkId, neat::LinkIdHash> essential_links;
 
-    for (const auto& neuron : genome.get_neurons()) {
+    for (const auto& neuron : neurons) {
         if (neuron.neuron_id < config.num_inputs) {
-            for (const auto& link : genome.get_links()) {
+            for (const auto& link : links) {
                 if (link.link_id.input_id == neuron.neuron_id) {
                     essential_links.insert(link.link_id);
                 }
@@ -77,10 +82,10 @@ void Mutator::mutate_remove_link(Genome &genome) {
         }
     }
 
-    for (const auto& neuron : genome.get_neurons()) {
+    for (const auto& neuron : neurons) {
         if (neuron.neuron_id >= config.num_inputs && 
             neuron.neuron_id < config.num_inputs + config.num_outputs) {
-            for (const auto& link : genome.get_links()) {
+            for (const auto& link : links) {
                 if (link.link_id.output_id == neuron.neuron_id) {
                     essential_links.insert(link.link_id);
                 }
@@ -88,14 +93,14 @@ void Mutator::mutate_remove_link(Genome &genome) {
         }
     }
 
-    for (const auto& link : genome.get_links()) {
+    for (const auto& link : links) {
         if (link.link_id.input_id >= config.num_inputs && link.link_id.output_id >= config.num_inputs) {
             essential_links.insert(link.link_id);
         }
     }
 
     std::vector<neat::LinkGene> removable_links;
-    for (const auto& link : genome.get_links()) {
+    for (const auto& link : links) {
         if (essential_links.find(link.link_id) == essential_links.end()) {
             removable_links.push_back(link);
         }
@@ -106,38 +111,43 @@ void Mutator::mutate_remove_link(Genome &genome) {
     }
 
     auto to_remove = rng.choose_random(removable_links);
-    genome.get_links().erase(std::remove(genome.get_links().begin(), genome.get_links().end(), to_remove), genome.get_links().end());
+    genome.remove_link(to_remove.link_id);
 }
 
-void Mutator::mutate_add_neuron(Genome &genome) {
-    RNG rng;
+void Mutator::mutate_add_neuron(Genome &genome, RNG &rng, InnovationTracker &innovations) {
+    const Genome &view = genome;
 
-    if (genome.get_links().empty()) {
+    if (view.get_links().empty()) {
         return;
     }
 
-    neat::LinkGene link_to_split = rng.choose_random(genome.get_links());
-    link_to_split.is_enabled = false;
+    neat::LinkGene link_to_split = rng.choose_random(view.get_links());
+    genome.remove_link(link_to_split.link_id);
+
+    neat::LinkId link_id = link_to_split.link_id;
+    double weight = link_to_split.weight;
 
-    genome.get_links().erase(std::remove_if(genome.get_links().begin(), genome.get_links().end(),
-        [&link_to_split](const neat::LinkGene &link) {
-            return link.link_id == link_to_split.link_id;
-        }), genome.get_links().end());
+    // Même lien divisé => même neurone dans toute la population
+    int neuron_id = innovations.split_neuron_id(link_id);
+    if (view.find_neuron(neuron_id)) {
+        neuron_id = innovations.new_neuron_id();
+    }
 
-    neat::NeuronMutator neuron_mutator;
+    neat::NeuronMutator neuron_mutator(rng);
     neat::NeuronGene new_neuron = neuron_mutator.new_neuron();
-    new_neuron.neuron_id = genome.generate_next_neuron_id();
+    new_neuron.neuron_id = neuron_id;
     genome.add_neuron(new_neuron);
 
-    neat::LinkId link_id = link_to_split.link_id;
-    double weight = link_to_split.weight;
-
-    genome.add_link(neat::LinkGene{{link_id.input_id, new_neuron.neuron_id}, 1.0, true});
-    genome.add_link(neat::LinkGene{{new_neuron.neuron_id, link_id.output_id}, weight, true});
+    neat::LinkId in_link{link_id.input_id, neuron_id};
+    neat::LinkId out_link{neuron_id, link_id.output_id};
+    genome.add_link(neat::LinkGene{in_link, 1.0, true, innovations.link_innovation(in_link)});
+    genome.add_link(neat::LinkGene{out_link, weight, true, innovations.link_innovation(out_link)});
 }
 
-void Mutator::mutate_remove_neuron(Genome &genome) {
-    int hidden_neuron_count = std::count_if(genome.get_neurons().begin(), genome.get_neurons().end(), 
+void Mutator::mutate_remove_neuron(Genome &genome, RNG &rng) {
+    const Genome &view = genome;
+    const auto &neurons = view.get_neurons();
+    int hidden_neuron_count = std::count_if(neurons.begin(), neurons.end(), 
         [](const neat::NeuronGene &neuron) { 
             NeatConfig config;
             return neuron.is_hidden(neuron.neuron_id, config);
@@ -147,55 +157,72 @@ void Mutator::mutate_remove_neuron(Genome &genome) {
         return;
     }
 
-    RNG rng;
-    auto neuron_it = choose_random_hidden(genome.get_neurons());
-
-    genome.get_links().erase(std::remove_if(genome.get_links().begin(), genome.get_links().end(), 
-        [neuron_it](const neat::LinkGene &link) {
-            return link.has_neuron(*neuron_it);
-        }),
-        genome.get_links().end());
+    auto neuron_it = choose_random_hidden(neurons, rng);
 
-    genome.get_neurons().erase(neuron_it);
+    // Supprime le neurone et tous les liens qui le touchent
+    genome.remove_neuron(neuron_it->neuron_id);
 }
 
 void Mutator::mutate_link_weight(Genome &genome, const NeatConfig &config, RNG &rng) {
+    // Lecture seule : la structure du génome n'est pas modifiée
+    const Genome &view = genome;
+    const auto &links = view.get_links();
+
     // Vérifie s'il y a des liens à muter
-    if (genome.get_links().empty()) {
+    if (links.empty()) {
         return;
     }
 
     // Choisir un lien aléatoire
-    int link_index = rng.next_int(0, genome.get_links().size() - 1);
-    auto &link = genome.get_links()[link_index];
+    int link_index = rng.next_int(0, links.size() - 1);
 
     // Appliquer la mutation si la probabilité le permet
     if (rng.next_double() < config.probability_mutate_link_weight) {
-        std::cout << "Mutating link weight for genome " << genome.get_genome_id() << std::endl;
-        link.weight = mutate_delta(link.weight);  // Muter le poids du lien
+        genome.set_link_weight(link_index, mutate_delta(neat::link_weight(links, link_index), rng));  // Muter le poids du lien
+    }
+}
+
+void Mutator::mutate_link_weights(Genome &genome, const NeatConfig &config, RNG &rng) {
+    const Genome &view = genome;
+    const auto &links = view.get_links();
+
+    // Liens retenus et leurs poids, puis toutes les perturbations d'un coup
+    std::vector<std::size_t> selected;
+    std::vector<double> weights;
+    for (std::size_t i = 0; i < links.size(); ++i) {
+        if (rng.next_double() < config.probability_mutate_link_weight) {
+            selected.push_back(i);
+            weights.push_back(neat::link_weight(links, i));
+        }
+    }
+    mutate_deltas(weights.data(), weights.size(), rng);
+    for (std::size_t k = 0; k < selected.size(); ++k) {
+        genome.set_link_weight(selected[k], weights[k]);
     }
 }
 
 void Mutator::mutate_neuron_bias(Genome &genome, const NeatConfig &config, RNG &rng) {
+    // Lecture seule : la structure du génome n'est pas modifiée
+    const Genome &view = genome;
+    const auto &neurons = view.get_neurons();
+
     // Vérifie s'il y a des neurones à muter
-    if (genome.get_neurons().empty()) {
+    if (neurons.empty()) {
         return;
     }
 
     // Choisir un neurone aléatoire
-    int neuron_index = rng.next_int(0, genome.get_neurons().size() - 1);
-    auto &neuron = genome.get_neurons()[neuron_index];
+    int neuron_index = rng.next_int(0, neurons.size() - 1);
 
     // Appliquer la mutation si la probabilité le permet
     if (rng.next_double() < config.probability_mutate_neuron_bias) {
-        std::cout << "Mutating neuron bias for genome " << genome.get_genome_id() << std::endl;
-        neuron.bias = mutate_delta(neuron.bias);  // Muter le biais du neurone
+        genome.set_neuron_bias(neuron_index, mutate_delta(neat::neuron_bias(neurons, neuron_index), rng));  // Muter le biais du neurone
     }
 }
 
 
 
-int choose_random_input_or_hidden_neuron(const std::vector<neat::NeuronGene>& neurons) {
+int choose_random_input_or_hidden_neuron(const neat::NeuronGenes& neurons, RNG &rng) {
     std::vector<int> valid_neurons;
     NeatConfig config;
 
@@ -210,11 +237,10 @@ int choose_random_input_or_hidden_neuron(const std::vector<neat::NeuronGene>& ne
         return -1;
     }
 
-    int random_index = std::rand() % valid_neurons.size();
-    return valid_neurons[random_index];
+    return rng.choose_random(valid_neurons);
 }
 
-int choose_random_output_or_hidden_neuron(const std::vector<neat::NeuronGene>& neurons) {
+int choose_random_output_or_hidden_neuron(const neat::NeuronGenes& neurons, RNG &rng) {
     std::vector<int> valid_neurons;
     NeatConfig config;
 
@@ -227,12 +253,11 @@ int choose_random_output_or_hidden_neuron(const std::vector<neat::NeuronGene>& n
     if (valid_neurons.empty()) {
         return -1;
     }
-    int random_index = std::rand() % valid_neurons.size();
-    return valid_neurons[random_index];
+    return rng.choose_random(valid_neurons);
 }
 
-std::vector<neat::NeuronGene>::const_iterator choose_random_hidden(std::vector<neat::NeuronGene>& neurons) {
-    std::vector<std::vector<neat::NeuronGene>::const_iterator> hidden_neurons;
+neat::NeuronGenes::const_iterator choose_random_hidden(const neat::NeuronGenes& neurons, RNG &rng) {
+    std::vector<neat::NeuronGenes::const_iterator> hidden_neurons;
     NeatConfig config;
 
     for (auto it = neurons.begin(); it != neurons.end(); ++it) {
@@ -245,47 +270,30 @@ std::vector<neat::NeuronGene>::const_iterator choose_random_hidden(std::vector<n
         throw std::out_of_range("No hidden neurons available.");
     }
 
-    RNG rng;
     return rng.choose_random(hidden_neurons);
 }
 
 
 
-bool would_create_cycle(const std::vector<neat::LinkGene>& links, int input_id, int output_id) {
-    std::unordered_set<int> visited;
-
-    std::function<bool(int)> dfs = [&](int current_id) {
-        if (visited.find(current_id) != visited.end()) {
-            return true;
-        }
-        visited.insert(current_id);
-
-        for (const auto& link : links) {
-            if (link.link_id.input_id == current_id) {
-                if (link.link_id.output_id == input_id) {
-                    return true;
-                }
-                if (dfs(link.link_id.output_id)) {
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
-
-    return dfs(output_id);
-}
-
-double new_value(){
-    RNG rng;
+double new_value(RNG &rng){
     neat::DoubleConfig config;
     return neat::clamp(rng.next_gaussian(config.init_mean, config.init_stdev));
 }
 
-double mutate_delta(double value){
-    RNG rng;
+double mutate_delta(double value, RNG &rng){
     neat::DoubleConfig config;
     double delta = neat::clamp( rng.next_gaussian(0, config.mutate_power));
     return neat::clamp (value + delta);
 }
 
+void mutate_deltas(double *values, std::size_t n, RNG &rng) {
+    neat::DoubleConfig config;
+    std::vector<double> deltas(n);
+    rng.fill_gaussian(deltas.data(), n, 0.0, config.mutate_power);
+    // Même calcul que neat::clamp, en ligne pour que la boucle soit vectorisée
+    auto clamp = [&](double x) { return std::min(config.max_value, std::max(config.min_value, x)); };
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = clamp(values[i] + clamp(deltas[i]));
+    }
+}
+
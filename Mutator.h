@@ -5,12 +5,13 @@
 #include "Genome.h"
 #include "RNG.h"
 #include "NeatConfig.h"
+#include "InnovationTracker.h"
 
 class Mutator
 {
 public:
-    // Méthode pour appliquer différentes mutations sur un génome
-    static void mutate(Genome &genome, const NeatConfig &config, RNG &rng);
+    // Méthode pour appliquer différentes mutations sur un génome ; les nouveaux gènes sont numérotés par `innovations`
+    static void mutate(Genome &genome, const NeatConfig &config, RNG &rng, InnovationTracker &innovations);
 
     // Mutations spécifiques
 
@@ -34,6 +35,18 @@ public:
      */
     static void mutate_link_weight(Genome &genome, const NeatConfig &config, RNG &rng);
 
+    /**
+     * @brief Perturbe les poids de tous les liens du génome, chacun avec la probabilité `config.probability_mutate_link_weight`.
+     *
+     * Variante par lot de `mutate_link_weight` : les liens sont d'abord tirés, puis leurs perturbations sont tirées
+     * d'un seul appel à `RNG::fill_gaussian` (voir `mutate_deltas`).
+     *
+     * @param genome Le génome à muter.
+     * @param config La configuration NEAT utilisée pour la mutation.
+     * @param rng Une référence à un générateur de nombres aléatoires.
+     */
+    static void mutate_link_weights(Genome &genome, const NeatConfig &config, RNG &rng);
+
     /**
      * @brief Modifie le génome donné en modifiant le biais d’un neurone aléatoire.
      *
@@ -60,6 +73,8 @@ public:
      * que l’ajout du lien ne crée pas de cycle dans le réseau.
      *
      * @param genome Le génome à muter.
+     * @param rng Une référence à un générateur de nombres aléatoires.
+     * @param innovations Le registre des numéros d'innovation de la population.
      *
      * @détails La fonction effectue les étapes suivantes :
      * - Choisit une entrée aléatoire ou un neurone caché.
@@ -70,7 +85,7 @@ public:
      * - Si le lien n’existe pas, il vérifie si l’ajout du lien créerait un cycle.
      * - Si l’ajout du lien ne crée pas de cycle, il crée et ajoute le nouveau lien au génome.
      */
-    static void mutate_add_link(Genome &genome);
+    static void mutate_add_link(Genome &genome, RNG &rng, InnovationTracker &innovations);
 
     /**
      * @brief Modifie le génome donné en supprimant un lien non essentiel.
@@ -81,8 +96,9 @@ public:
      * et liens entre les neurones cachés.
      *
      * @param genome Le génome à muter.
+     * @param rng Une référence à un générateur de nombres aléatoires.
      */
-    static void mutate_remove_link(Genome &genome);
+    static void mutate_remove_link(Genome &genome, RNG &rng);
 
     /**
      * @brief Modifie le génome donné en ajoutant un nouveau neurone.
@@ -90,16 +106,18 @@ public:
      * Cette fonction effectue les étapes suivantes :
      * 1. Vérifie si le génome a des liens. Sinon, il revient immédiatement.
      * 2. Sélectionne une liaison aléatoire à partir du génome pour le fractionnement.
-     * 3. Désactive le lien sélectionné.
-     * 4. Supprime le lien désactivé du génome.
-     * 5. Crée un nouveau neurone en utilisant le NeuronMutator.
-     * 6. Génère un nouvel ID de neurone et ajoute le nouveau neurone au génome.
-     * 7. Ajoute un nouveau lien du neurone d’entrée du lien de division au nouveau neurone avec un poids de 1.0.
-     * 8. Ajoute un nouveau lien du nouveau neurone au neurone de sortie du lien divisé avec le poids du lien d’origine.
+     * 3. Supprime le lien sélectionné du génome.
+     * 4. Crée un nouveau neurone en utilisant le NeuronMutator.
+     * 5. Lui attribue l’ID associé à la division de ce lien dans toute la population (ou un ID neuf
+     *    si ce neurone est déjà présent dans le génome) et l’ajoute au génome.
+     * 6. Ajoute un nouveau lien du neurone d’entrée du lien de division au nouveau neurone avec un poids de 1.0.
+     * 7. Ajoute un nouveau lien du nouveau neurone au neurone de sortie du lien divisé avec le poids du lien d’origine.
      *
      * @param genome Le génome à muter en ajoutant un nouveau neurone.
+     * @param rng Une référence à un générateur de nombres aléatoires.
+     * @param innovations Le registre des numéros d'innovation de la population.
      */
-    static void mutate_add_neuron(Genome &genome);
+    static void mutate_add_neuron(Genome &genome, RNG &rng, InnovationTracker &innovations);
 
     /**
      * @brief Modifie le génome donné en supprimant un neurone caché.
@@ -109,8 +127,9 @@ public:
      * Ensuite, il sélectionne au hasard un neurone caché, supprime tous les liens qui lui sont associés et enfin supprime le neurone lui-même.
      *
      * @param genome Le génome à muter.
+     * @param rng Une référence à un générateur de nombres aléatoires.
      */
-    static void mutate_remove_neuron(Genome &genome);
+    static void mutate_remove_neuron(Genome &genome, RNG &rng);
 };
 
 // Méthodes utilitaires pour choisir des neurones aléatoires
@@ -123,10 +142,11 @@ public:
  * num_inputs + num_outputs - 1). Il sélectionne ensuite de façon aléatoire l’un de ces neurones valides.
  *
  * @param neurons Un vecteur d’objets NeuronGene représentant les neurones.
+ * @param rng Une référence à un générateur de nombres aléatoires.
  * @return L’identifiant d’un neurone caché ou d’une entrée choisie au hasard. Si aucun neurone valide n’est trouvé,
  *   renvoie -1.
  */
-static int choose_random_input_or_hidden_neuron(const std::vector<neat::NeuronGene> &neurons);
+static int choose_random_input_or_hidden_neuron(const neat::NeuronGenes &neurons, RNG &rng);
 
 /**
  * @brief Sélectionne une sortie aléatoire ou un neurone caché dans une liste de neurones.
@@ -136,9 +156,10 @@ static int choose_random_input_or_hidden_neuron(const std::vector<neat::NeuronGe
  * sélectionne au hasard un de ces neurones valides et renvoie son identifiant.
  *
  * @param neurons Un vecteur d’objets NeuronGene représentant les neurones à choisir.
+ * @param rng Une référence à un générateur de nombres aléatoires.
  * @return L’identifiant d’un neurone valide choisi au hasard, ou -1 si aucun neurone valide n’est trouvé.
  */
-static int choose_random_output_or_hidden_neuron(const std::vector<neat::NeuronGene> &neurons);
+static int choose_random_output_or_hidden_neuron(const neat::NeuronGenes &neurons, RNG &rng);
 
 // Méthodes pour choisir des neurones cachés aléatoires
 
@@ -150,27 +171,12 @@ static int choose_random_output_or_hidden_neuron(const std::vector<neat::NeuronG
  * ou égal à la somme du nombre d’entrées et de sorties. Il sélectionne ensuite au hasard
  * un de ces neurones cachés et renvoie un itérateur à celui-ci.
  *
- * @param neurons Référence à un vecteur d’objets NeuronGene représentant les neurones.
+ * @param neurons Référence constante à un vecteur d’objets NeuronGene représentant les neurones.
+ * @param rng Une référence à un générateur de nombres aléatoires.
  * @return Un itérateur à un neurone caché choisi au hasard.
  * @throws std::out_of_range Si aucun neurone caché n’est disponible dans la liste.
  */
-std::vector<neat::NeuronGene>::const_iterator choose_random_hidden(std::vector<neat::NeuronGene> &neurons);
-
-// Méthode pour vérifier si un cycle serait créé par l'ajout d'un lien
-
-/**
- * @brief Vérifie si l’ajout d’un lien entre deux neurones créerait un cycle dans le réseau.
- *
- * Cette fonction utilise un algorithme de recherche en profondeur pour déterminer si un cycle serait créé.
- * en ajoutant un lien entre le neurone avec l’identifiant `input_id` et le neurone avec l'«output_id`. Il traverse la
- * réseau à partir du neurone `output_id`et vérifie s’il peut atteindre le neurone `input_id`.
- *
- * @param links Un vecteur de `neat::LinkGene` représentant les liens existants dans le réseau.
- * @param input_id L’ID du neurone d’entrée du lien à ajouter.
- * @param output_id L’ID du neurone de sortie du lien à ajouter.
- * @return true si l’ajout du lien créerait un cycle, false sinon.
- */
-bool would_create_cycle(const std::vector<neat::LinkGene> &links, int input_id, int output_id);
+neat::NeuronGenes::const_iterator choose_random_hidden(const neat::NeuronGenes &neurons, RNG &rng);
 
 /**
  * @brief Génère une nouvelle valeur basée sur une distribution gaussienne.
@@ -179,9 +185,10 @@ bool would_create_cycle(const std::vector<neat::LinkGene> &links, int input_id,
  * avec une moyenne et un écart-type spécifiés. La valeur est ensuite serrée pour assurer
  * il se situe dans une fourchette valable.
  *
+ * @param rng Une référence à un générateur de nombres aléatoires.
  * @return Un double représentant la nouvelle valeur clampée générée à partir de la distribution gaussienne.
  */
-double new_value();
+double new_value(RNG &rng);
 
 /**
  * @brief Fait muter une valeur donnée en ajoutant un delta généré à partir d'une distribution gaussienne.
@@ -191,8 +198,18 @@ double new_value();
  * d'entrée, et le résultat est à nouveau limité avant d'être retourné.
  *
  * @param value La valeur initiale à faire muter.
+ * @param rng Une référence à un générateur de nombres aléatoires.
  * @return La valeur mutée après ajout du delta limité.
  */
-double mutate_delta(double value);
+double mutate_delta(double value, RNG &rng);
+
+/**
+ * @brief Applique `mutate_delta` à `n` valeurs, dont les `n` deltas sont tirés d'un seul appel à `RNG::fill_gaussian`.
+ *
+ * @param values Les valeurs à faire muter, modifiées sur place.
+ * @param n Le nombre de valeurs.
+ * @param rng Une référence à un générateur de nombres aléatoires.
+ */
+void mutate_deltas(double *values, std::size_t n, RNG &rng);
 
 #endif // MUTATOR_H
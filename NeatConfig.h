@@ -1,6 +1,20 @@
 #ifndef NEATCONFIG_H
 #define NEATCONFIG_H
 
+// Méthode de sélection des parents (voir ParentSelector)
+enum class SelectionScheme {
+    Truncation,          // Tirage uniforme parmi les meilleurs (survival_threshold)
+    Tournament,          // Meilleur de tournament_size individus tirés au hasard
+    FitnessProportional, // Roulette, tirage en O(1) par table d'alias
+    StochasticUniversal  // Roulette à pointeurs régulièrement espacés (SUS)
+};
+
+// Stockage des génomes de la population
+enum class GenomeStorage {
+    Shared, // Un objet par génome, possédé par des std::shared_ptr (voir generation_arena)
+    Pool    // Pool contigu, individus référencés par indice (voir GenomePool)
+};
+
 struct NeatConfig {
     int population_size = 10;        // Taille de la population
     int num_inputs = 1;               // Nombre d'entrées
@@ -16,6 +30,26 @@ struct NeatConfig {
 
     // Seuil de survie pour la sélection
     double survival_threshold = 0.3;  // Pourcentage d'individus qui survivent à chaque génération
+    SelectionScheme selection = SelectionScheme::Truncation;  // Méthode de sélection des parents
+    int tournament_size = 3;          // Nombre d'individus par tournoi (SelectionScheme::Tournament)
+    int elitism = 1;                  // Nombre de meilleurs individus recopiés tels quels (avec leur fitness) dans la génération suivante
+
+    // Spéciation (voir Speciation)
+    bool speciation = true;                          // Reproduction au sein des espèces, avec partage de fitness
+    double compatibility_threshold = 3.0;            // Distance en dessous de laquelle deux génomes sont de la même espèce
+    double compatibility_excess_coefficient = 1.0;   // Poids des liens en excès dans la distance
+    double compatibility_disjoint_coefficient = 1.0; // Poids des liens disjoints
+    double compatibility_weight_coefficient = 0.4;   // Poids de la différence moyenne des poids des liens communs
+
+    // Mémoïsation des fitness : à n'activer que si la fitness ne dépend que du génome (pas du flux aléatoire de l'individu)
+    int fitness_cache_capacity = 0;  // Nombre de fitness gardées d'une génération à l'autre (0 : pas de table)
+
+    // Mémoire
+    GenomeStorage genome_storage = GenomeStorage::Shared;
+    bool generation_arena = true;  // Génomes des descendants alloués dans une arène libérée en bloc à chaque génération (Shared)
+
+    // Parallélisme
+    int num_threads = 0;  // Nombre de threads d'évaluation (0 : autant que de cœurs disponibles)
 };
 
 #endif // NEATCONFIG_H
@@ -0,0 +1,158 @@
+#include "NetworkCache.h"
+#include <unordered_set>
+
+FeedForwardNeuralNetwork &NetworkCache::get(const Genome &genome)
+{
+    auto it = m_entries.find(genome.get_genome_id());
+    if (it != m_entries.end() && it->second.structure_version == genome.get_structure_version())
+    {
+        Entry &entry = it->second;
+        if (entry.parameter_version == genome.get_parameter_version())
+        {
+            ++m_hits;
+            return entry.network;
+        }
+
+        // Seuls des poids ou des biais ont changé : la structure est celle du réseau, seuls les gènes
+        // modifiés sont recopiés (tous, si le génome ne les connaît plus)
+        FeedForwardNeuralNetwork &network = entry.network;
+        const auto &links = genome.get_links();
+        const auto &neurons = genome.get_neurons();
+        bool replayed = genome.for_each_parameter_change(entry.parameter_version, [&](const Genome::ParameterChange &change)
+        {
+            if (change.is_link)
+            {
+                const neat::LinkGene link = links[change.index];
+                if (link.is_enabled)
+                {
+                    network.set_link_weight(link.link_id, link.weight);
+                }
+            }
+            else
+            {
+                const neat::NeuronGene neuron = neurons[change.index];
+                network.set_neuron_bias(neuron.neuron_id, neuron.bias);
+            }
+        });
+        if (!replayed)
+        {
+            network.assign_parameters(genome);
+        }
+        ++m_patches;
+        entry.parameter_version = genome.get_parameter_version();
+        return network;
+    }
+
+    std::size_t structural_hash = genome.structural_hash();
+
+    // Génome inconnu : réutilise le réseau d'un génome de même structure s'il y en a un
+    auto model = m_by_structure.find(structural_hash);
+    if (model != m_by_structure.end())
+    {
+        auto model_entry = m_entries.find(model->second);
+        if (model_entry != m_entries.end() && model_entry->second.network.matches_structure(genome))
+        {
+            FeedForwardNeuralNetwork network = model_entry->second.network;
+            network.load_parameters(genome);
+            ++m_patches;
+            return store(genome, structural_hash, std::move(network));
+        }
+    }
+
+    ++m_misses;
+    return store(genome, structural_hash, FeedForwardNeuralNetwork::create_from_genome(genome));
+}
+
+FeedForwardNeuralNetwork &NetworkCache::store(const Genome &genome, std::size_t structural_hash, FeedForwardNeuralNetwork network)
+{
+    Entry entry{genome.get_structure_version(), genome.get_parameter_version(), structural_hash, std::move(network)};
+    m_by_structure[structural_hash] = genome.get_genome_id();
+
+    auto it = m_entries.find(genome.get_genome_id());
+    if (it != m_entries.end())
+    {
+        it->second = std::move(entry);
+        return it->second.network;
+    }
+    return m_entries.emplace(genome.get_genome_id(), std::move(entry)).first->second.network;
+}
+
+void NetworkCache::retain(const std::vector<neat::Individual> &individuals)
+{
+    std::unordered_set<int> alive;
+    for (const auto &individual : individuals)
+    {
+        alive.insert(individual.genome->get_genome_id());
+    }
+
+    // Un génome disparu qui sert encore de modèle pour sa structure est gardé une génération de plus,
+    // pour que ses descendants de même structure puissent reprendre son réseau
+    std::unordered_set<int> kept_as_model;
+    for (auto it = m_entries.begin(); it != m_entries.end();)
+    {
+        auto model = m_by_structure.find(it->second.structural_hash);
+        bool is_model = model != m_by_structure.end() && model->second == it->first;
+        if (alive.count(it->first))
+        {
+            ++it;
+        }
+        else if (is_model && !m_kept_as_model.count(it->first))
+        {
+            kept_as_model.insert(it->first);
+            ++it;
+        }
+        else
+        {
+            it = m_entries.erase(it);
+        }
+    }
+    m_kept_as_model = std::move(kept_as_model);
+
+    // Les modèles de structure ne doivent désigner que des génomes encore en cache
+    for (auto it = m_by_structure.begin(); it != m_by_structure.end();)
+    {
+        auto entry = m_entries.find(it->second);
+        if (entry != m_entries.end() && entry->second.structural_hash == it->first)
+        {
+            ++it;
+        }
+        else
+        {
+            it = m_by_structure.erase(it);
+        }
+    }
+}
+
+void NetworkCache::clear()
+{
+    m_entries.clear();
+    m_by_structure.clear();
+    m_kept_as_model.clear();
+}
+
+std::size_t NetworkCache::size() const
+{
+    return m_entries.size();
+}
+
+std::size_t NetworkCache::hits() const
+{
+    return m_hits;
+}
+
+std::size_t NetworkCache::misses() const
+{
+    return m_misses;
+}
+
+std::size_t NetworkCache::patches() const
+{
+    return m_patches;
+}
+
+void NetworkCache::reset_counters()
+{
+    m_hits = 0;
+    m_misses = 0;
+    m_patches = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef NETWORK_CACHE_H
+#define NETWORK_CACHE_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <cstddef>
+#include "neat.h"
+#include "Genome.h"
+#include "NeuralNetwork.h"
+
+class NetworkCache
+{
+public:
+    /**
+     * @brief Retourne le réseau compilé d'un génome, en le construisant si nécessaire.
+     *
+     * Les réseaux sont indexés par identifiant de génome :
+     * - si ni la structure ni les paramètres du génome n'ont changé, le réseau en cache est réutilisé ;
+     * - si seuls les poids ou les biais ont changé, le réseau est corrigé en place, gène modifié par gène
+     *   modifié (voir Genome::for_each_parameter_change), ou entièrement si le génome ne les connaît plus ;
+     * - si le génome est inconnu mais qu'un génome de même structure est en cache (par exemple un parent
+     *   dont il ne diffère que par les poids), son réseau est copié puis corrigé ;
+     * - sinon le réseau est entièrement recompilé.
+     *
+     * @param genome Le génome dont on veut le réseau.
+     * @return FeedForwardNeuralNetwork& Le réseau compilé, valide jusqu'au prochain appel modifiant le cache.
+     */
+    FeedForwardNeuralNetwork &get(const Genome &genome);
+
+    /**
+     * @brief Supprime du cache les génomes qui ne font plus partie de la population.
+     *
+     * @param individuals Les individus dont les réseaux doivent être conservés.
+     */
+    void retain(const std::vector<neat::Individual> &individuals);
+
+    void clear();
+
+    std::size_t size() const;
+    std::size_t hits() const;
+    std::size_t misses() const;  // Compilations complètes
+    std::size_t patches() const; // Réseaux corrigés en place sans recompilation
+
+    // Remet les compteurs à zéro
+    void reset_counters();
+
+private:
+    struct Entry
+    {
+        unsigned long structure_version;
+        unsigned long parameter_version;
+        std::size_t structural_hash;
+        FeedForwardNeuralNetwork network;
+    };
+
+    FeedForwardNeuralNetwork &store(const Genome &genome, std::size_t structural_hash, FeedForwardNeuralNetwork network);
+
+    std::unordered_map<int, Entry> m_entries;
+    std::unordered_map<std::size_t, int> m_by_structure; // Empreinte structurelle -> génome servant de modèle
+    std::unordered_set<int> m_kept_as_model;             // Génomes disparus conservés uniquement comme modèles
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+    std::size_t m_patches = 0;
+};
+
+#endif // NETWORK_CACHE_H
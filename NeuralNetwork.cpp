@@ -1,50 +1,364 @@
 #include "NeuralNetwork.h"
+#include "ActivationKernels.h"
 #include <unordered_set>
 #include <iostream>
+#include <algorithm>
+
+/**
+ * @brief Compile les neurones en un programme à index denses.
+ */
+FeedForwardNeuralNetwork::FeedForwardNeuralNetwork(std::vector<int> input_ids, std::vector<int> output_ids, std::vector<Neuron> neurons)
+    : m_input_ids(std::move(input_ids)), m_output_ids(std::move(output_ids))
+{
+    std::unordered_map<int, int> slots;
+    auto slot_of = [&slots](int neuron_id)
+    {
+        auto it = slots.find(neuron_id);
+        if (it != slots.end())
+        {
+            return it->second;
+        }
+        int slot = static_cast<int>(slots.size());
+        slots.emplace(neuron_id, slot);
+        return slot;
+    };
+
+    // Les entrées occupent les premiers slots, suivies des sorties
+    for (int input_id : m_input_ids)
+    {
+        slot_of(input_id);
+    }
+    for (int output_id : m_output_ids)
+    {
+        m_output_slots.push_back(slot_of(output_id));
+    }
+
+    std::size_t total_inputs = 0;
+    for (const Neuron &neuron : neurons)
+    {
+        total_inputs += neuron.inputs.size();
+    }
+
+    m_program.reserve(neurons.size());
+    m_program_inputs.reserve(total_inputs);
+    for (const Neuron &neuron : neurons)
+    {
+        m_neuron_program[neuron.neuron_id] = m_program.size();
+        CompiledNeuron compiled{neuron.neuron_id, slot_of(neuron.neuron_id), neuron.activation, neuron.bias, m_program_inputs.size(), neuron.inputs.size()};
+        for (const NeuronInput &input : neuron.inputs)
+        {
+            m_link_inputs[neat::LinkId{input.input_id, neuron.neuron_id}] = m_program_inputs.size();
+            // Un neurone source jamais évalué garde la valeur 0.0
+            m_program_inputs.push_back(CompiledInput{slot_of(input.input_id), input.weight});
+        }
+        m_program.push_back(std::move(compiled));
+    }
+
+    m_values.assign(slots.size(), 0.0);
+}
 
 /**
  * @brief Active le réseau de neurones avec un ensemble d'entrées.
  */
 std::vector<double> FeedForwardNeuralNetwork::activate(const std::vector<double> &inputs)
+{
+    std::vector<double> outputs;
+    activate(inputs, outputs);
+    return outputs;
+}
+
+void FeedForwardNeuralNetwork::activate(const std::vector<double> &inputs, std::vector<double> &outputs)
 {
     assert(inputs.size() == m_input_ids.size());
-    std::unordered_map<int, double> values;
 
-    for (size_t i = 0; i < inputs.size(); i++)
+    std::fill(m_values.begin(), m_values.end(), 0.0);
+    std::copy(inputs.begin(), inputs.end(), m_values.begin());
+
+    const CompiledInput *program_inputs = m_program_inputs.data();
+    double *values = m_values.data();
+
+    for (const CompiledNeuron &neuron : m_program)
     {
-        int input_id = m_input_ids[i];
-        values[input_id] = inputs[i];
+        double value = neuron.bias;
+
+        const CompiledInput *input = program_inputs + neuron.first_input;
+        const CompiledInput *end = input + neuron.num_inputs;
+        for (; input != end; ++input)
+        {
+            value += values[input->slot] * input->weight;
+        }
+
+        values[neuron.slot] = std::visit([value](auto &&fn)
+                                         { return fn(value); }, neuron.activation);
     }
 
-    for (int output_id : m_output_ids)
+    outputs.resize(m_output_slots.size());
+    for (std::size_t i = 0; i < m_output_slots.size(); i++)
     {
-        values[output_id] = 0.0;
+        outputs[i] = values[m_output_slots[i]];
     }
+}
 
-    for (const auto &neuron : m_neurons)
+/**
+ * @brief Active le réseau de neurones sur un lot d'entrées.
+ */
+void FeedForwardNeuralNetwork::activate_batch(const double *inputs, std::size_t num_samples, double *outputs, BatchLayout layout)
+{
+    const std::size_t n = num_samples;
+    const std::size_t num_inputs = m_input_ids.size();
+    const std::size_t num_outputs = m_output_slots.size();
+
+    m_batch_values.assign(m_values.size() * n, 0.0);
+    double *values = m_batch_values.data();
+
+    // Les entrées occupent les premiers slots
+    for (std::size_t i = 0; i < num_inputs; i++)
     {
-        double value = neuron.bias;
+        double *row = values + i * n;
+        for (std::size_t s = 0; s < n; s++)
+        {
+            row[s] = layout == BatchLayout::RowMajor ? inputs[s * num_inputs + i] : inputs[i * n + s];
+        }
+    }
 
-        for (const NeuronInput &input : neuron.inputs)
+    for (const CompiledNeuron &neuron : m_program)
+    {
+        double *row = values + static_cast<std::size_t>(neuron.slot) * n;
+        std::fill(row, row + n, neuron.bias);
+
+        for (std::size_t k = neuron.first_input; k < neuron.first_input + neuron.num_inputs; k++)
         {
-            assert(values.find(input.input_id) != values.end());
-            value += values[input.input_id] * input.weight;
+            const double *source = values + static_cast<std::size_t>(m_program_inputs[k].slot) * n;
+            const double weight = m_program_inputs[k].weight;
+            for (std::size_t s = 0; s < n; s++)
+            {
+                row[s] += source[s] * weight;
+            }
         }
 
-        value = std::visit([&value](auto &&fn)
-                           { return fn(value); }, neuron.activation);
-        values[neuron.neuron_id] = value;
+        // Une seule résolution du variant par neurone, puis un noyau vectorisé sur les échantillons
+        apply_activation(neuron.activation, row, n);
     }
 
-    std::vector<double> outputs;
-    for (int output_id : m_output_ids)
+    for (std::size_t o = 0; o < num_outputs; o++)
     {
-        assert(values.find(output_id) != values.end());
-        outputs.push_back(values[output_id]);
+        const double *row = values + static_cast<std::size_t>(m_output_slots[o]) * n;
+        for (std::size_t s = 0; s < n; s++)
+        {
+            if (layout == BatchLayout::RowMajor)
+            {
+                outputs[s * num_outputs + o] = row[s];
+            }
+            else
+            {
+                outputs[o * n + s] = row[s];
+            }
+        }
     }
+}
+
+std::vector<double> FeedForwardNeuralNetwork::activate_batch(const std::vector<double> &inputs, std::size_t num_samples, BatchLayout layout)
+{
+    if (inputs.size() != num_samples * m_input_ids.size())
+    {
+        throw std::invalid_argument("activate_batch: inputs size does not match num_samples * num_inputs.");
+    }
+    std::vector<double> outputs(num_samples * m_output_slots.size());
+    activate_batch(inputs.data(), num_samples, outputs.data(), layout);
     return outputs;
 }
 
+/**
+ * @brief Vérifie qu'un génome a la structure compilée dans ce réseau.
+ */
+bool FeedForwardNeuralNetwork::matches_structure(const Genome &genome) const
+{
+    if (static_cast<std::size_t>(genome.get_num_inputs()) != m_input_ids.size() ||
+        static_cast<std::size_t>(genome.get_num_outputs()) != m_output_ids.size())
+    {
+        return false;
+    }
+
+    std::size_t enabled_links = 0;
+    for (const auto &link : genome.get_links())
+    {
+        // Seuls les liens vers un neurone évalué font partie du programme
+        if (link.is_enabled && m_neuron_program.count(link.link_id.output_id))
+        {
+            if (!m_link_inputs.count(link.link_id))
+            {
+                return false;
+            }
+            ++enabled_links;
+        }
+    }
+    if (enabled_links != m_program_inputs.size())
+    {
+        return false;
+    }
+
+    std::size_t matched_neurons = 0;
+    for (const auto &neuron : genome.get_neurons())
+    {
+        auto it = m_neuron_program.find(neuron.neuron_id);
+        if (it != m_neuron_program.end())
+        {
+            if (convert_activation(neuron.activation).index() != m_program[it->second].activation.index())
+            {
+                return false;
+            }
+            ++matched_neurons;
+        }
+    }
+    return matched_neurons == m_program.size();
+}
+
+/**
+ * @brief Évalue plusieurs génomes de même structure, poids et biais en colonnes.
+ */
+void FeedForwardNeuralNetwork::activate_columns(const std::vector<const Genome *> &genomes, const std::vector<double> &inputs, std::size_t num_samples, std::vector<double> &outputs)
+{
+    const std::size_t num_genomes = genomes.size();
+    const std::size_t width = num_samples * num_genomes; // Une ligne de valeurs par slot : [échantillon][génome]
+    const std::size_t num_inputs = m_input_ids.size();
+    const std::size_t num_outputs = m_output_slots.size();
+    assert(inputs.size() == num_samples * num_inputs);
+
+    // Poids et biais de chaque génome, rangés en colonnes
+    std::vector<double> weights(m_program_inputs.size() * num_genomes, 0.0);
+    std::vector<double> biases(m_program.size() * num_genomes, 0.0);
+    for (std::size_t g = 0; g < num_genomes; g++)
+    {
+        for (const auto &link : genomes[g]->get_links())
+        {
+            if (!link.is_enabled || !m_neuron_program.count(link.link_id.output_id))
+            {
+                continue;
+            }
+            auto it = m_link_inputs.find(link.link_id);
+            if (it == m_link_inputs.end())
+            {
+                throw std::invalid_argument("activate_columns: genome structure does not match the compiled network.");
+            }
+            weights[it->second * num_genomes + g] = link.weight;
+        }
+        for (const auto &neuron : genomes[g]->get_neurons())
+        {
+            auto it = m_neuron_program.find(neuron.neuron_id);
+            if (it != m_neuron_program.end())
+            {
+                biases[it->second * num_genomes + g] = neuron.bias;
+            }
+        }
+    }
+
+    m_batch_values.assign(m_values.size() * width, 0.0);
+    double *values = m_batch_values.data();
+
+    for (std::size_t i = 0; i < num_inputs; i++)
+    {
+        double *row = values + i * width;
+        for (std::size_t s = 0; s < num_samples; s++)
+        {
+            std::fill(row + s * num_genomes, row + (s + 1) * num_genomes, inputs[s * num_inputs + i]);
+        }
+    }
+
+    for (std::size_t j = 0; j < m_program.size(); j++)
+    {
+        const CompiledNeuron &neuron = m_program[j];
+        double *row = values + static_cast<std::size_t>(neuron.slot) * width;
+        const double *bias = biases.data() + j * num_genomes;
+        for (std::size_t s = 0; s < num_samples; s++)
+        {
+            std::copy(bias, bias + num_genomes, row + s * num_genomes);
+        }
+
+        for (std::size_t k = neuron.first_input; k < neuron.first_input + neuron.num_inputs; k++)
+        {
+            const double *source = values + static_cast<std::size_t>(m_program_inputs[k].slot) * width;
+            const double *weight = weights.data() + k * num_genomes;
+            for (std::size_t s = 0; s < num_samples; s++)
+            {
+                double *out = row + s * num_genomes;
+                const double *in = source + s * num_genomes;
+                for (std::size_t g = 0; g < num_genomes; g++)
+                {
+                    out[g] += in[g] * weight[g];
+                }
+            }
+        }
+
+        apply_activation(neuron.activation, row, width);
+    }
+
+    outputs.resize(num_genomes * num_samples * num_outputs);
+    for (std::size_t o = 0; o < num_outputs; o++)
+    {
+        const double *row = values + static_cast<std::size_t>(m_output_slots[o]) * width;
+        for (std::size_t s = 0; s < num_samples; s++)
+        {
+            for (std::size_t g = 0; g < num_genomes; g++)
+            {
+                outputs[(g * num_samples + s) * num_outputs + o] = row[s * num_genomes + g];
+            }
+        }
+    }
+}
+
+bool FeedForwardNeuralNetwork::set_link_weight(neat::LinkId link_id, double weight)
+{
+    auto it = m_link_inputs.find(link_id);
+    if (it == m_link_inputs.end())
+    {
+        return false;
+    }
+    m_program_inputs[it->second].weight = weight;
+    return true;
+}
+
+bool FeedForwardNeuralNetwork::set_neuron_bias(int neuron_id, double bias)
+{
+    auto it = m_neuron_program.find(neuron_id);
+    if (it == m_neuron_program.end())
+    {
+        return false;
+    }
+    m_program[it->second].bias = bias;
+    return true;
+}
+
+/**
+ * @brief Recharge les poids et biais d'un génome de même structure.
+ */
+bool FeedForwardNeuralNetwork::load_parameters(const Genome &genome)
+{
+    if (!matches_structure(genome))
+    {
+        return false;
+    }
+    assign_parameters(genome);
+    return true;
+}
+
+/**
+ * @brief Recharge les poids et biais d'un génome dont la structure est celle du réseau.
+ */
+void FeedForwardNeuralNetwork::assign_parameters(const Genome &genome)
+{
+    for (const auto &link : genome.get_links())
+    {
+        if (link.is_enabled)
+        {
+            set_link_weight(link.link_id, link.weight);
+        }
+    }
+    for (const auto &neuron : genome.get_neurons())
+    {
+        set_neuron_bias(neuron.neuron_id, neuron.bias);
+    }
+}
+
 /**
  * @brief Crée un réseau neuronal à partir d'un génome.
  */
@@ -53,38 +367,61 @@ FeedForwardNeuralNetwork FeedForwardNeuralNetwork::create_from_genome(const Geno
     std::vector<int> inputs = genome.make_input_ids();
     std::vector<int> outputs = genome.make_output_ids();
 
+    const neat::LinkGenes &links = genome.get_links();
+    const neat::NeuronGenes &neuron_genes = genome.get_neurons();
+
     assert(!inputs.empty() && "Inputs cannot be empty.");
     assert(!outputs.empty() && "Outputs cannot be empty.");
-    assert(!genome.get_links().empty() && "Links cannot be empty.");
+    assert(!links.empty() && "Links cannot be empty.");
+
+    // Regroupe les entrées de chaque neurone en un seul passage sur les liens
+    std::unordered_map<int, std::vector<NeuronInput>> inputs_by_neuron;
+    for (const auto &link : links)
+    {
+        if (link.is_enabled)
+        {
+            inputs_by_neuron[link.link_id.output_id].push_back(NeuronInput{link.link_id.input_id, link.weight});
+        }
+    }
+
+    std::unordered_map<int, neat::NeuronGene> genes_by_id;
+    for (const auto &neuron_gene : neuron_genes)
+    {
+        genes_by_id.emplace(neuron_gene.neuron_id, neuron_gene);
+    }
+
+    std::unordered_set<int> input_set(inputs.begin(), inputs.end());
 
     LayerManager layer_manager;
-    std::vector<std::vector<int>> layers = layer_manager.organize_layers(inputs, outputs, genome.get_links());
+    std::vector<std::vector<int>> layers = layer_manager.organize_layers(inputs, outputs, links);
 
+    // Les couches sont déjà dans l'ordre topologique : aucun tri supplémentaire n'est nécessaire
     std::vector<Neuron> neurons;
     for (const auto &layer : layers)
     {
-        std::vector<int> sorted_layer = layer_manager.sort_by_layer(layer, genome.get_links());
-
-        for (int neuron_id : sorted_layer)
+        for (int neuron_id : layer)
         {
-            std::vector<NeuronInput> neuron_inputs;
-
-            for (const auto &link : genome.get_links())
+            // Les neurones d'entrée reçoivent directement les valeurs fournies à activate
+            if (input_set.count(neuron_id))
             {
-                if (neuron_id == link.link_id.output_id)
-                {
-                    neuron_inputs.emplace_back(NeuronInput{link.link_id.input_id, link.weight});
-                }
+                continue;
             }
 
-            auto neuron_gene_opt = genome.find_neuron(neuron_id);
+            auto gene_it = genes_by_id.find(neuron_id);
             // Vérification : assure qu'un neurone est trouvé dans le génome
-            if (!neuron_gene_opt.has_value())
+            if (gene_it == genes_by_id.end())
             {
                 std::cerr << "Neuron ID " << neuron_id << " not found in genome." << std::endl;
                 throw std::runtime_error("Neuron not found.");
             }
-            const neat::NeuronGene &neuron_gene = *neuron_gene_opt;
+            const neat::NeuronGene &neuron_gene = gene_it->second;
+
+            std::vector<NeuronInput> neuron_inputs;
+            auto inputs_it = inputs_by_neuron.find(neuron_id);
+            if (inputs_it != inputs_by_neuron.end())
+            {
+                neuron_inputs = std::move(inputs_it->second);
+            }
 
             neurons.emplace_back(Neuron{neuron_gene.neuron_id, convert_activation(neuron_gene.activation), neuron_gene.bias, std::move(neuron_inputs)});
         }
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <cstddef>
 #include <cassert>
 #include <optional>
 #include <variant>
@@ -24,16 +25,47 @@ struct Neuron
     std::vector<NeuronInput> inputs;
 };
 
+// Entrée compilée : index dense (slot) du neurone source et poids du lien
+struct CompiledInput
+{
+    int slot;
+    double weight;
+};
+
+// Neurone compilé : ses entrées occupent [first_input, first_input + num_inputs) dans le tableau des entrées
+struct CompiledNeuron
+{
+    int neuron_id;
+    int slot;
+    ActivationFn activation;
+    double bias;
+    std::size_t first_input;
+    std::size_t num_inputs;
+};
+
+// Disposition mémoire des tampons d'entrées/sorties pour l'activation par lots
+enum class BatchLayout
+{
+    RowMajor,   // Un échantillon par ligne : buffer[sample * width + column]
+    ColumnMajor // Une colonne par neurone : buffer[column * num_samples + sample]
+};
+
 class FeedForwardNeuralNetwork
 {
 public:
     /**
-     * @brief Constructeur par défaut pour la classe FeedForwardNeuralNetwork.
+     * @brief Construit un FeedForwardNeuralNetwork à partir des neurones triés dans l'ordre d'évaluation.
+     *
+     * Les identifiants de neurones sont remappés vers des index denses (slots) : les entrées occupent
+     * les premiers slots, puis les sorties, puis les neurones cachés. Les entrées de chaque neurone sont
+     * stockées de façon contiguë sous forme de paires (slot, poids), ce qui permet à `activate` de
+     * travailler sur un unique vecteur de valeurs préalloué, sans table de hachage.
      *
-     * Initialise un objet FeedForwardNeuralNetwork avec des vecteurs vides pour les identifiants d'entrée et de sortie, ainsi qu'une liste vide de neurones.
+     * @param input_ids Les identifiants des neurones d'entrée.
+     * @param output_ids Les identifiants des neurones de sortie.
+     * @param neurons Les neurones à évaluer, dans l'ordre topologique.
      */
-    FeedForwardNeuralNetwork(std::vector<int> input_ids, std::vector<int> output_ids, std::vector<Neuron> neurons)
-        : m_input_ids(std::move(input_ids)), m_output_ids(std::move(output_ids)), m_neurons(std::move(neurons)) {}
+    FeedForwardNeuralNetwork(std::vector<int> input_ids, std::vector<int> output_ids, std::vector<Neuron> neurons);
 
     /**
      * @brief Active le réseau de neurones avec un ensemble d'entrées.
@@ -50,6 +82,109 @@ public:
      */
     std::vector<double> activate(const std::vector<double> &inputs);
 
+    /**
+     * @brief Active le réseau de neurones en écrivant les sorties dans un vecteur fourni.
+     *
+     * Variante de `activate` qui réutilise la capacité de `outputs` et n'effectue donc aucune
+     * allocation une fois le vecteur dimensionné.
+     *
+     * @param inputs Un vecteur d'entrées à fournir au réseau de neurones.
+     * @param outputs Le vecteur qui reçoit les valeurs de sortie.
+     */
+    void activate(const std::vector<double> &inputs, std::vector<double> &outputs);
+
+    /**
+     * @brief Active le réseau de neurones sur un lot de vecteurs d'entrée en un seul passage.
+     *
+     * Le programme de neurones est parcouru une seule fois : pour chaque neurone, la boucle interne
+     * traite les N échantillons sur des lignes contiguës, ce qui permet au compilateur de la vectoriser.
+     *
+     * @param inputs Tampon N×num_inputs des entrées, dans la disposition `layout`.
+     * @param num_samples Le nombre d'échantillons N.
+     * @param outputs Tampon N×num_outputs qui reçoit les sorties, dans la même disposition.
+     * @param layout La disposition des tampons d'entrées et de sorties.
+     */
+    void activate_batch(const double *inputs, std::size_t num_samples, double *outputs, BatchLayout layout = BatchLayout::RowMajor);
+
+    /**
+     * @brief Variante de `activate_batch` sur des vecteurs.
+     *
+     * @param inputs Vecteur N×num_inputs des entrées.
+     * @param num_samples Le nombre d'échantillons N.
+     * @param layout La disposition des vecteurs d'entrées et de sorties.
+     * @return Un vecteur N×num_outputs des sorties.
+     *
+     * @throws std::invalid_argument Si la taille de `inputs` ne vaut pas N×num_inputs.
+     */
+    std::vector<double> activate_batch(const std::vector<double> &inputs, std::size_t num_samples, BatchLayout layout = BatchLayout::RowMajor);
+
+    std::size_t num_inputs() const { return m_input_ids.size(); }
+    std::size_t num_outputs() const { return m_output_ids.size(); }
+
+    /**
+     * @brief Vérifie qu'un génome a exactement la structure compilée dans ce réseau.
+     *
+     * La structure comprend les liens activés, les neurones évalués et leur fonction d'activation ;
+     * les poids et les biais peuvent différer.
+     *
+     * @param genome Le génome à comparer.
+     * @return true si les poids et biais du génome peuvent être évalués avec ce programme.
+     */
+    bool matches_structure(const Genome &genome) const;
+
+    /**
+     * @brief Évalue plusieurs génomes de même structure en un seul passage sur la topologie.
+     *
+     * Les poids et biais deviennent des colonnes (une par génome) : chaque neurone est traité une seule fois
+     * pour tous les génomes et tous les échantillons. Tous les génomes reçoivent les mêmes entrées.
+     *
+     * @param genomes Les génomes à évaluer ; chacun doit vérifier `matches_structure`.
+     * @param inputs Vecteur N×num_inputs des entrées, en disposition ligne par échantillon.
+     * @param num_samples Le nombre d'échantillons N.
+     * @param outputs Reçoit G×N×num_outputs valeurs : outputs[(g * N + s) * num_outputs + o].
+     *
+     * @throws std::invalid_argument Si un génome contient un lien activé absent du programme.
+     */
+    void activate_columns(const std::vector<const Genome *> &genomes, const std::vector<double> &inputs, std::size_t num_samples, std::vector<double> &outputs);
+
+    /**
+     * @brief Modifie en place le poids d'un lien du programme compilé.
+     *
+     * @param link_id Le lien à modifier.
+     * @param weight Le nouveau poids.
+     * @return true si le lien fait partie du programme, false sinon.
+     */
+    bool set_link_weight(neat::LinkId link_id, double weight);
+
+    /**
+     * @brief Modifie en place le biais d'un neurone du programme compilé.
+     *
+     * @param neuron_id Le neurone à modifier.
+     * @param bias Le nouveau biais.
+     * @return true si le neurone fait partie du programme, false sinon.
+     */
+    bool set_neuron_bias(int neuron_id, double bias);
+
+    /**
+     * @brief Recharge tous les poids et biais d'un génome de même structure, sans recompiler.
+     *
+     * Seuls les paramètres sont recopiés : l'ordre topologique et les slots sont conservés.
+     *
+     * @param genome Le génome dont on reprend les poids et les biais.
+     * @return true si le génome a la structure du réseau (voir `matches_structure`) ; sinon le réseau n'est pas modifié.
+     */
+    bool load_parameters(const Genome &genome);
+
+    /**
+     * @brief Comme `load_parameters`, sans vérifier la structure.
+     *
+     * Pour l'appelant qui sait déjà que le génome a la structure du réseau (même génome, même version
+     * structurelle) : évite la comparaison complète de `matches_structure`.
+     *
+     * @param genome Le génome dont on reprend les poids et les biais.
+     */
+    void assign_parameters(const Genome &genome);
+
     /**
      * @brief Crée un feedforward neural network à partir d'un génome.
      *
@@ -65,7 +200,13 @@ public:
 private:
     std::vector<int> m_input_ids;
     std::vector<int> m_output_ids;
-    std::vector<Neuron> m_neurons;
+    std::vector<int> m_output_slots;
+    std::vector<CompiledNeuron> m_program;
+    std::vector<CompiledInput> m_program_inputs;
+    std::unordered_map<neat::LinkId, std::size_t, neat::LinkIdHash> m_link_inputs; // Lien -> index dans m_program_inputs
+    std::unordered_map<int, std::size_t> m_neuron_program;                       // Neurone -> index dans m_program
+    std::vector<double> m_values; // Valeurs des neurones indexées par slot, réutilisées d'un appel à l'autre
+    std::vector<double> m_batch_values; // Valeurs par lot : une ligne de N échantillons par slot
 };
 
 /**
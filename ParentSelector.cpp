@@ -0,0 +1,148 @@
+#include "ParentSelector.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+ParentSelector::ParentSelector(const std::vector<double> &fitness, const NeatConfig &config)
+    : fitness(fitness), scheme(config.selection), tournament_size(std::max(1, config.tournament_size)) {
+    if (fitness.empty()) {
+        throw std::runtime_error("ParentSelector : la population est vide.");
+    }
+
+    switch (scheme) {
+    case SelectionScheme::Truncation:
+        build_survivors(config.survival_threshold);
+        break;
+    case SelectionScheme::Tournament:
+        break;
+    case SelectionScheme::FitnessProportional:
+    case SelectionScheme::StochasticUniversal:
+        build_alias_table();
+        break;
+    }
+}
+
+void ParentSelector::build_survivors(double survival_threshold) {
+    // Les meilleurs individus sont placés en tête par nth_element, sans trier le reste
+    std::size_t cutoff = static_cast<std::size_t>(std::ceil(survival_threshold * fitness.size()));
+    cutoff = std::min(std::max<std::size_t>(cutoff, 1), fitness.size());
+
+    survivors.resize(fitness.size());
+    std::iota(survivors.begin(), survivors.end(), 0);
+    std::nth_element(survivors.begin(), survivors.begin() + (cutoff - 1), survivors.end(),
+        [this](std::size_t a, std::size_t b) { return fitness[a] > fitness[b]; });
+    survivors.resize(cutoff);
+}
+
+void ParentSelector::build_alias_table() {
+    // Poids décalés pour que le moins bon individu ait un poids nul ; fitness toutes égales : tirage uniforme
+    const double min_fitness = *std::min_element(fitness.begin(), fitness.end());
+    const std::size_t n = fitness.size();
+    weights.resize(n);
+    total_weight = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        weights[i] = fitness[i] - min_fitness;
+        total_weight += weights[i];
+    }
+    if (!(total_weight > 0.0) || !std::isfinite(total_weight)) {
+        std::fill(weights.begin(), weights.end(), 1.0);
+        total_weight = static_cast<double>(n);
+    }
+
+    // Méthode de Vose : chaque case contient sa probabilité propre et un alias pour le reste
+    alias_probability.resize(n);
+    alias.resize(n);
+    std::vector<double> scaled(n);
+    std::vector<std::size_t> small, large;
+    for (std::size_t i = 0; i < n; ++i) {
+        scaled[i] = weights[i] * n / total_weight;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+    while (!small.empty() && !large.empty()) {
+        std::size_t low = small.back();
+        small.pop_back();
+        std::size_t high = large.back();
+        alias_probability[low] = scaled[low];
+        alias[low] = high;
+        scaled[high] -= 1.0 - scaled[low];
+        if (scaled[high] < 1.0) {
+            large.pop_back();
+            small.push_back(high);
+        }
+    }
+    // Cases restantes (erreurs d'arrondi comprises) : probabilité 1
+    for (std::size_t i : large) {
+        alias_probability[i] = 1.0;
+        alias[i] = i;
+    }
+    for (std::size_t i : small) {
+        alias_probability[i] = 1.0;
+        alias[i] = i;
+    }
+}
+
+std::size_t ParentSelector::select(RNG &rng) const {
+    const int last = static_cast<int>(fitness.size()) - 1;
+
+    switch (scheme) {
+    case SelectionScheme::Truncation:
+        return rng.choose_random(survivors, static_cast<int>(survivors.size()));
+
+    case SelectionScheme::Tournament: {
+        std::size_t winner = static_cast<std::size_t>(rng.next_int(0, last));
+        for (int round = 1; round < tournament_size; ++round) {
+            std::size_t challenger = static_cast<std::size_t>(rng.next_int(0, last));
+            if (fitness[challenger] > fitness[winner]) {
+                winner = challenger;
+            }
+        }
+        return winner;
+    }
+
+    case SelectionScheme::FitnessProportional:
+    case SelectionScheme::StochasticUniversal:
+    default: {
+        std::size_t column = static_cast<std::size_t>(rng.next_int(0, last));
+        return rng.next_double() < alias_probability[column] ? column : alias[column];
+    }
+    }
+}
+
+std::vector<std::size_t> ParentSelector::draw_all(std::size_t count, RNG &rng) const {
+    std::vector<std::size_t> parents;
+    if (scheme != SelectionScheme::StochasticUniversal || count == 0) {
+        return parents;
+    }
+
+    // Pointeurs espacés de `step` sur la roue, à partir d'une seule position aléatoire
+    parents.reserve(count);
+    const double step = total_weight / count;
+    double pointer = rng.next_double() * step;
+    double cumulative = weights[0];
+    std::size_t index = 0;
+    for (std::size_t k = 0; k < count; ++k) {
+        while (pointer >= cumulative && index + 1 < weights.size()) {
+            cumulative += weights[++index];
+        }
+        parents.push_back(index);
+        pointer += step;
+    }
+
+    // Les parents sortent groupés par individu : mélange de Fisher-Yates pour former des couples au hasard
+    for (std::size_t k = count - 1; k > 0; --k) {
+        std::size_t other = static_cast<std::size_t>(rng.next_int(0, static_cast<int>(k)));
+        std::swap(parents[k], parents[other]);
+    }
+    return parents;
+}
+
+std::vector<std::size_t> ParentSelector::best(const std::vector<double> &fitness, std::size_t count) {
+    count = std::min(count, fitness.size());
+    std::vector<std::size_t> indices(fitness.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    std::partial_sort(indices.begin(), indices.begin() + count, indices.end(),
+        [&fitness](std::size_t a, std::size_t b) { return fitness[a] > fitness[b]; });
+    indices.resize(count);
+    return indices;
+}
@@ -0,0 +1,82 @@
+#ifndef PARENT_SELECTOR_H
+#define PARENT_SELECTOR_H
+
+#include "NeatConfig.h"
+#include "rng.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Sélection des parents d'une génération à partir de la fitness des individus.
+ *
+ * Le sélecteur ne manipule que des indices : les individus ne sont jamais copiés ni triés.
+ * Les structures nécessaires à la méthode choisie (`config.selection`) sont préparées une fois
+ * par génération, en O(n) (O(n + k log k) pour les k élites), puis chaque tirage coûte O(1)
+ * (O(taille du tournoi) pour le tournoi).
+ *
+ * Une fois construit, le sélecteur n'est plus modifié : `select` peut être appelé depuis
+ * plusieurs threads, chacun avec son propre flux aléatoire.
+ */
+class ParentSelector
+{
+public:
+    /**
+     * @brief Prépare la sélection pour une génération.
+     *
+     * @param fitness La fitness de chaque individu.
+     * @param config La configuration (méthode de sélection, seuil de survie, taille du tournoi).
+     */
+    ParentSelector(const std::vector<double> &fitness, const NeatConfig &config);
+
+    /**
+     * @brief Tire l'index d'un parent.
+     *
+     * Pour la sélection universelle stochastique, qui tire tous les parents d'un coup, un tirage
+     * isolé se comporte comme la sélection proportionnelle à la fitness (voir `draw_all`).
+     *
+     * @param rng Le flux aléatoire du tirage.
+     * @return std::size_t L'index du parent choisi.
+     */
+    std::size_t select(RNG &rng) const;
+
+    /**
+     * @brief Tire tous les parents d'une génération en une fois, si la méthode l'exige.
+     *
+     * Seule la sélection universelle stochastique (SUS) procède ainsi : un unique tirage place
+     * `count` pointeurs régulièrement espacés sur la roue des fitness, puis les parents obtenus
+     * sont mélangés pour former les couples. Pour les autres méthodes, le vecteur retourné est vide
+     * et les parents sont tirés un à un avec `select`.
+     *
+     * @param count Le nombre de parents à tirer.
+     * @param rng Le flux aléatoire.
+     * @return std::vector<std::size_t> Les indices des parents, ou un vecteur vide.
+     */
+    std::vector<std::size_t> draw_all(std::size_t count, RNG &rng) const;
+
+    /**
+     * @brief Retourne les indices des `count` meilleurs individus, du meilleur au moins bon.
+     *
+     * @param fitness La fitness de chaque individu.
+     * @param count Le nombre d'individus voulus (borné par la taille de la population).
+     * @return std::vector<std::size_t> Les indices des meilleurs individus.
+     */
+    static std::vector<std::size_t> best(const std::vector<double> &fitness, std::size_t count);
+
+private:
+    void build_survivors(double survival_threshold);
+    void build_alias_table();
+
+    std::vector<double> fitness;
+    SelectionScheme scheme;
+    int tournament_size;
+
+    std::vector<std::size_t> survivors; // Troncature : meilleurs individus, dans un ordre quelconque
+
+    // Roue des fitness (proportionnelle et SUS) : poids décalés pour être positifs
+    std::vector<double> weights;
+    double total_weight = 0.0;
+    std::vector<double> alias_probability; // Méthode des alias de Vose : tirage en O(1)
+    std::vector<std::size_t> alias;
+};
+
+#endif // PARENT_SELECTOR_H
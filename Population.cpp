@@ -5,17 +5,45 @@
 #include "Neat.h"
 #include "Genome.h"
 #include <iostream>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 
 
 Population::Population(NeatConfig config, RNG &rng) 
-    : config{config}, rng{rng}, next_genome_id{0} {
+    : config{config}, rng{rng}, next_genome_id{0},
+      innovation_tracker{config.num_inputs + config.num_outputs},
+      fitness_cache{static_cast<std::size_t>(std::max(0, config.fitness_cache_capacity))},
+      speciation{config} {
+    // La génération initiale a aussi son arène (ou ses slots dans le pool), créée ici en série
+    std::vector<neat::GenomeHandle> handles;
+    if (config.genome_storage == GenomeStorage::Pool) {
+        genome_pool = std::make_shared<GenomePool>();
+        handles = genome_pool->allocate(static_cast<std::size_t>(std::max(0, config.population_size)));
+    } else if (config.generation_arena) {
+        arena = std::make_shared<GenerationArena>(1);
+    }
+    GenerationArena::Scope scope(arena.get(), 0);
     for (int i = 0; i < config.population_size; ++i) {
         int num_hidden_neurons = rng.next_int(1, 4);  // Random hidden neurons
-std::shared_ptr<Genome> genome = std::make_shared<Genome>(Genome::create_genome(generate_next_genome_id(), config.num_inputs, config.num_outputs, num_hidden_neurons, rng));
-individuals.emplace_back(genome);
-
+        Genome created = Genome::create_genome(generate_next_genome_id(), config.num_inputs, config.num_outputs, num_hidden_neurons, rng, innovation_tracker);
+        if (genome_pool) {
+            (*genome_pool)[handles[i]] = std::move(created);
+            individuals.emplace_back(genome_pool->view(handles[i]), handles[i]);
+        } else {
+            individuals.emplace_back(arena ? GenerationArena::make_shared<Genome>(arena, 0, std::move(created))
+                                           : std::make_shared<Genome>(std::move(created)));
+        }
+    }
+    if (genome_pool) {
+        genome_pool->set_generation(std::move(handles));
     }
 }
 
@@ -27,36 +55,235 @@ int Population::generate_next_genome_id() {
     return next_genome_id++;
 }
 
-void Population::mutate(Genome &genome) {
-    Mutator::mutate(genome, config, rng);
+int Population::reserve_genome_ids(int count) {
+    int first_id = next_genome_id;
+    next_genome_id += count;
+    return first_id;
 }
 
-std::vector<neat::Individual> Population::reproduce() {
-    auto old_members = sort_individuals_by_fitness(individuals);
-    int reproduction_cutoff = std::ceil(config.survival_threshold * old_members.size());
-    std::vector<neat::Individual> new_generation;
+void Population::mutate(Genome &genome) {
+    Mutator::mutate(genome, config, rng, innovation_tracker);
+}
 
-    std::cout << "Reproducing..." << std::endl;
+namespace {
+    // Individus qui se reproduisent entre eux (une espèce, ou toute la population) et cases qu'ils remplissent
+    struct BreedingGroup {
+        std::vector<std::size_t> members;       // Indices dans la population
+        ParentSelector selector;                // Tire des indices dans `members`
+        std::vector<std::size_t> drawn_parents; // Parents tirés d'un coup (SUS) ; vide sinon
+        std::size_t first_slot;
+    };
+}
 
-    while (new_generation.size() < config.population_size) {
-        neat::Individual& p1 = rng.choose_random(old_members, reproduction_cutoff);
-        neat::Individual& p2 = rng.choose_random(old_members, reproduction_cutoff);
+std::vector<neat::Individual> Population::reproduce() {
+    return breed(nullptr, config.num_threads);
+}
 
-        std::cout << "Crossover between " << p1.genome->get_genome_id() << " and " << p2.genome->get_genome_id() << std::endl;
+std::vector<neat::Individual> Population::reproduce_and_evaluate(const GenomeFitnessFunction &fitness_fn, std::size_t num_threads) {
+    const std::size_t workers = get_thread_pool(num_threads).size();
+    std::vector<double> evaluation_busy(workers, 0.0);
+    std::vector<std::size_t> evaluated(workers, 0);
+    std::vector<std::size_t> hits(workers, 0);
+    std::mutex cache_mutex; // La table de transposition est partagée par les workers
+    fitness_cache.reset_stats(); // Avant la reproduction : les évictions sont comptées par `store`
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<neat::Individual> new_generation = breed(
+        [&](neat::Individual &offspring, RNG &offspring_rng, std::size_t worker) {
+            const auto evaluation_start = std::chrono::steady_clock::now();
+            const bool use_table = fitness_cache.capacity() > 0;
+            const std::uint64_t key = use_table ? offspring.genome->content_hash() : 0;
+            bool known = false;
+            if (use_table) {
+                std::lock_guard<std::mutex> lock(cache_mutex);
+                known = fitness_cache.lookup(key, offspring.fitness);
+            }
+            if (known) {
+                ++hits[worker];
+            } else {
+                offspring.fitness = fitness_fn(*offspring.genome, offspring_rng, worker);
+                ++evaluated[worker];
+                if (use_table) {
+                    std::lock_guard<std::mutex> lock(cache_mutex);
+                    fitness_cache.store(key, offspring.fitness);
+                }
+            }
+            offspring.fitness_computed = true;
+            evaluation_busy[worker] += std::chrono::duration<double>(std::chrono::steady_clock::now() - evaluation_start).count();
+        },
+        num_threads);
+
+    pipeline_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    pipeline_stats.workers = workers;
+    pipeline_stats.evaluation_busy_seconds = std::accumulate(evaluation_busy.begin(), evaluation_busy.end(), 0.0);
+    // Le temps mesuré par breed pour chaque descendant comprend son évaluation
+    pipeline_stats.reproduction_busy_seconds -= pipeline_stats.evaluation_busy_seconds;
+
+    FitnessCache::Stats &stats = fitness_cache.get_stats();
+    stats.evaluated = std::accumulate(evaluated.begin(), evaluated.end(), std::size_t{0});
+    stats.hits = std::accumulate(hits.begin(), hits.end(), std::size_t{0});
+    stats.reused = new_generation.size() - stats.evaluated - stats.hits; // Élites
+    return new_generation;
+}
 
-        neat::Neat neat_instance;
-        Genome offspring = neat_instance.crossover(p1.genome, p2.genome, generate_next_genome_id());
+std::vector<neat::Individual> Population::breed(const BirthHook &on_birth, std::size_t num_threads) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<neat::Individual> &old_members = individuals;
+    std::vector<double> old_fitness(old_members.size());
+    for (std::size_t i = 0; i < old_members.size(); ++i) {
+        old_fitness[i] = old_members[i].fitness;
+    }
 
-        std::cout << "Offspring genome ID: " << offspring.get_genome_id() << std::endl;
+    // Les élites passent telles quelles, avec leur fitness : elles ne seront pas réévaluées
+    const std::vector<std::size_t> elites = ParentSelector::best(old_fitness,
+        std::min(static_cast<std::size_t>(std::max(0, config.elitism)), static_cast<std::size_t>(config.population_size)));
+    const std::size_t num_elites = elites.size();
+    const std::size_t num_offspring = config.population_size - num_elites;
 
-        mutate(offspring);
+    std::cout << "Reproducing..." << std::endl;
 
-        
+    // Identifiants et flux aléatoires réservés en série : chaque descendant peut ensuite être
+    // produit sur n'importe quel thread, directement dans sa case de la nouvelle génération
+    const int first_genome_id = reserve_genome_ids(static_cast<int>(num_offspring));
+    std::vector<RNG> streams;
+    streams.reserve(num_offspring);
+    for (std::size_t slot = 0; slot < num_offspring; ++slot) {
+        streams.push_back(rng.split());
+    }
 
-        new_generation.push_back(neat::Individual(std::make_shared<Genome>(offspring)));
+    // Sélection sur les indices, sans tri complet ni copie des individus, au sein de chaque espèce
+    ThreadPool &pool = get_thread_pool(num_threads);
+    std::vector<BreedingGroup> groups;
+    std::vector<std::size_t> slot_group(num_offspring);
+    std::size_t next_slot = 0;
+    auto add_group = [&](const std::vector<std::size_t> &members, std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+        std::vector<double> member_fitness(members.size());
+        for (std::size_t k = 0; k < members.size(); ++k) {
+            member_fitness[k] = old_fitness[members[k]];
+        }
+        ParentSelector selector(member_fitness, config);
+        std::vector<std::size_t> drawn_parents = selector.draw_all(2 * count, rng);
+        std::fill(slot_group.begin() + next_slot, slot_group.begin() + next_slot + count, groups.size());
+        groups.push_back(BreedingGroup{members, std::move(selector), std::move(drawn_parents), next_slot});
+        next_slot += count;
+    };
+    if (config.speciation) {
+        speciation.speciate(old_members, pool);
+        speciation.allocate_offspring(old_members, num_offspring);
+        for (const Species &species : speciation.get_species()) {
+            add_group(species.members, species.offspring);
+        }
+    } else {
+        std::vector<std::size_t> everyone(old_members.size());
+        std::iota(everyone.begin(), everyone.end(), 0);
+        add_group(everyone, num_offspring);
+    }
 
+    // Arène de la nouvelle génération, dimensionnée d'après la consommation de la génération courante (plus 1/8).
+    // Les élites y sont recopiées pour ne pas retenir l'arène de l'ancienne génération.
+    // Avec le pool, les descendants prennent des slots libres et les élites gardent le leur.
+    std::shared_ptr<GenerationArena> offspring_arena;
+    std::vector<neat::GenomeHandle> offspring_handles;
+    if (genome_pool) {
+        offspring_handles = genome_pool->allocate(num_offspring);
+    } else if (config.generation_arena) {
+        offspring_arena = std::make_shared<GenerationArena>(pool.size(),
+            arena ? (arena->get_stats().bytes + arena->get_stats().bytes / 8) / pool.size() : 0);
+    }
+    std::vector<neat::Individual> new_generation(num_elites + num_offspring);
+    for (std::size_t elite = 0; elite < num_elites; ++elite) {
+        new_generation[elite] = old_members[elites[elite]];
+        if (offspring_arena) {
+            new_generation[elite].genome = GenerationArena::make_shared<Genome>(offspring_arena, 0, *new_generation[elite].genome);
+        }
     }
 
+    // Chaque descendant est muté sous un registre d'innovations provisoire, puis ses innovations sont numérotées
+    // en série dans l'ordre des cases : les numéros ne dépendent ni du nombre de threads ni de leur ordonnancement.
+    // Une case est publiée (et évaluée par `on_birth`) dès que toutes les précédentes sont numérotées.
+    const InnovationTracker::Snapshot snapshot = innovation_tracker.snapshot();
+    std::vector<std::unique_ptr<InnovationTracker>> drafts(num_offspring);
+    std::vector<std::optional<Genome>> bred(num_offspring);
+    std::vector<InnovationTracker::Renumbering> renumberings(num_offspring);
+    std::vector<char> done(num_offspring, 0);
+    std::mutex commit_mutex;
+    std::size_t committed = 0;          // Cases numérotées : [0, committed)
+    std::deque<std::size_t> publishable; // Cases numérotées en attente de publication
+
+    auto publish = [&](std::size_t slot, std::size_t worker) {
+        neat::Individual &child = new_generation[num_elites + slot];
+        {
+            GenerationArena::Scope scope(offspring_arena.get(), worker);
+            Genome offspring = renumberings[slot].empty() ? std::move(*bred[slot]) : renumberings[slot].apply(*bred[slot]);
+            bred[slot].reset();
+            if (genome_pool) {
+                const neat::GenomeHandle handle = offspring_handles[slot];
+                (*genome_pool)[handle] = std::move(offspring);
+                child = neat::Individual(genome_pool->view(handle), handle);
+            } else {
+                child = neat::Individual(offspring_arena
+                    ? GenerationArena::make_shared<Genome>(offspring_arena, worker, std::move(offspring))
+                    : std::make_shared<Genome>(std::move(offspring)));
+            }
+        }
+        if (on_birth) {
+            on_birth(child, streams[slot], worker);
+        }
+    };
+
+    std::vector<double> busy(pool.size(), 0.0);
+    pool.parallel_for(num_offspring, [&](std::size_t slot, std::size_t worker) {
+        const auto task_start = std::chrono::steady_clock::now();
+        RNG &offspring_rng = streams[slot];
+        const BreedingGroup &group = groups[slot_group[slot]];
+        const std::size_t draw = 2 * (slot - group.first_slot);
+        const bool drawn = !group.drawn_parents.empty();
+        const neat::Individual &p1 = old_members[group.members[drawn ? group.drawn_parents[draw] : group.selector.select(offspring_rng)]];
+        const neat::Individual &p2 = old_members[group.members[drawn ? group.drawn_parents[draw + 1] : group.selector.select(offspring_rng)]];
+
+        drafts[slot] = std::make_unique<InnovationTracker>(innovation_tracker, snapshot);
+        {
+            GenerationArena::Scope scope(offspring_arena.get(), worker);
+            neat::Neat neat_instance(offspring_rng);
+            Genome offspring = neat_instance.crossover(p1, p2, first_genome_id + static_cast<int>(slot));
+            Mutator::mutate(offspring, config, offspring_rng, *drafts[slot]);
+            bred[slot].emplace(std::move(offspring));
+        }
+
+        // Numérotation des cases consécutives prêtes, puis publication hors du verrou, y compris des cases
+        // produites par les autres workers
+        {
+            std::lock_guard<std::mutex> lock(commit_mutex);
+            done[slot] = 1;
+            for (; committed < num_offspring && done[committed]; ++committed) {
+                renumberings[committed] = innovation_tracker.commit(*drafts[committed]);
+                drafts[committed].reset();
+                publishable.push_back(committed);
+            }
+        }
+        while (true) {
+            std::size_t next;
+            {
+                std::lock_guard<std::mutex> lock(commit_mutex);
+                if (publishable.empty()) {
+                    break;
+                }
+                next = publishable.front();
+                publishable.pop_front();
+            }
+            publish(next, worker);
+        }
+        busy[worker] += std::chrono::duration<double>(std::chrono::steady_clock::now() - task_start).count();
+    });
+
+    pipeline_stats = PipelineStats{};
+    pipeline_stats.workers = pool.size();
+    pipeline_stats.reproduction_busy_seconds = std::accumulate(busy.begin(), busy.end(), 0.0);
+    pipeline_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    next_arena = std::move(offspring_arena);
     return new_generation;
 }
 
@@ -68,30 +295,36 @@ std::vector<neat::Individual> Population::reproduce_from_genomes(const std::vect
         throw std::runtime_error("Erreur : La liste de génomes est vide. Impossible de reproduire.");
     }
 
-    // Initialiser une instance de ComputeFitness
-    ComputeFitness compute_fitness(rng);
-
-    // Trier les génomes par fitness évaluée (sans stocker la fitness dans les objets Genome)
-    std::vector<std::shared_ptr<Genome>> sorted_genomes = genomes;
-    std::sort(sorted_genomes.begin(), sorted_genomes.end(),
-        [&compute_fitness](const std::shared_ptr<Genome>& a, const std::shared_ptr<Genome>& b) {
-            // Évaluer la fitness pour comparer les génomes
-            return compute_fitness(*a, /* ant_id */ 0) > compute_fitness(*b, /* ant_id */ 0);
-        });
+    // Une instance de ComputeFitness par thread, chaque génome n'est évalué qu'une fois
+    // (sans stocker la fitness dans les objets Genome). Leurs flux sont découpés d'un flux dédié :
+    // le flux de la population avance d'un seul découpage, quel que soit le nombre de threads
+    ThreadPool &pool = get_thread_pool(config.num_threads);
+    RNG fitness_rng = rng.split();
+    std::vector<ComputeFitness> fitness_workers;
+    fitness_workers.reserve(pool.size());
+    for (std::size_t worker = 0; worker < pool.size(); ++worker) {
+        fitness_workers.emplace_back(fitness_rng);
+    }
+    std::vector<double> scores(genomes.size());
+    pool.parallel_for(genomes.size(), [&](std::size_t index, std::size_t worker) {
+        scores[index] = fitness_workers[worker](*genomes[index], /* ant_id */ 0);
+    });
 
-    int reproduction_cutoff = std::ceil(config.survival_threshold * sorted_genomes.size());
+    const ParentSelector selector(scores, config);
+    const std::vector<std::size_t> drawn_parents = selector.draw_all(2 * config.population_size, rng);
     std::vector<neat::Individual> new_generation;
 
     std::cout << "Reproducing from custom genome list..." << std::endl;
 
     // Boucle pour créer la nouvelle génération
     while (new_generation.size() < config.population_size) {
-        const std::shared_ptr<Genome>& p1 = rng.choose_random(sorted_genomes, reproduction_cutoff);
-        const std::shared_ptr<Genome>& p2 = rng.choose_random(sorted_genomes, reproduction_cutoff);
+        const std::size_t draw = 2 * new_generation.size();
+        const std::shared_ptr<Genome>& p1 = genomes[drawn_parents.empty() ? selector.select(rng) : drawn_parents[draw]];
+        const std::shared_ptr<Genome>& p2 = genomes[drawn_parents.empty() ? selector.select(rng) : drawn_parents[draw + 1]];
 
         std::cout << "Crossover between " << p1->get_genome_id() << " and " << p2->get_genome_id() << std::endl;
 
-        neat::Neat neat_instance;
+        neat::Neat neat_instance(rng);
         Genome offspring_genome = neat_instance.alt_crossover(p1, p2, generate_next_genome_id());
         std::shared_ptr<Genome> offspring = std::make_shared<Genome>(offspring_genome);
 
@@ -108,15 +341,255 @@ std::vector<neat::Individual> Population::reproduce_from_genomes(const std::vect
 
 
 
-std::vector<neat::Individual> Population::sort_individuals_by_fitness(const std::vector<neat::Individual>& individuals) {
-    std::vector<neat::Individual> sorted_individuals = individuals;
-    std::sort(sorted_individuals.begin(), sorted_individuals.end(), 
-        [](const neat::Individual& a, const neat::Individual& b) {
-            return a.fitness > b.fitness;
+void Population::evaluate(const FitnessFunction &fitness_fn, std::size_t num_threads) {
+    // Un flux par individu, dérivé en série : le résultat ne dépend pas de l'ordonnancement
+    std::vector<RNG> streams;
+    streams.reserve(individuals.size());
+    for (std::size_t i = 0; i < individuals.size(); ++i) {
+        streams.push_back(rng.split());
+    }
+
+    // Individus à évaluer : ni déjà évalués, ni présents dans la table de transposition.
+    // Un contenu qui apparaît plusieurs fois dans la génération n'est évalué qu'une fois.
+    fitness_cache.reset_stats();
+    FitnessCache::Stats &stats = fitness_cache.get_stats();
+    const bool use_table = fitness_cache.capacity() > 0;
+    std::vector<std::size_t> pending;
+    std::vector<std::uint64_t> keys(individuals.size());
+    std::vector<std::pair<std::size_t, std::size_t>> duplicates; // (individu, individu évalué de même contenu)
+    std::unordered_map<std::uint64_t, std::size_t> pending_by_key;
+    for (std::size_t i = 0; i < individuals.size(); ++i) {
+        neat::Individual &individual = individuals[i];
+        if (individual.fitness_computed) {
+            ++stats.reused;
+            continue;
+        }
+        if (use_table) {
+            keys[i] = individual.genome->content_hash();
+            if (fitness_cache.lookup(keys[i], individual.fitness)) {
+                individual.fitness_computed = true;
+                ++stats.hits;
+                continue;
+            }
+            auto first = pending_by_key.emplace(keys[i], i);
+            if (!first.second) {
+                duplicates.emplace_back(i, first.first->second);
+                ++stats.hits;
+                continue;
+            }
+        }
+        pending.push_back(i);
+    }
+    stats.evaluated = pending.size();
+
+    std::vector<double> fitness(pending.size());
+    get_thread_pool(num_threads).parallel_for(pending.size(),
+        [&](std::size_t task, std::size_t worker) {
+            const std::size_t index = pending[task];
+            fitness[task] = fitness_fn(index, streams[index], worker);
         });
+
+    for (std::size_t task = 0; task < pending.size(); ++task) {
+        neat::Individual &individual = individuals[pending[task]];
+        individual.fitness = fitness[task];
+        individual.fitness_computed = true;
+        if (use_table) {
+            fitness_cache.store(keys[pending[task]], individual.fitness);
+        }
+    }
+    for (const auto &duplicate : duplicates) {
+        individuals[duplicate.first].fitness = individuals[duplicate.second].fitness;
+        individuals[duplicate.first].fitness_computed = true;
+    }
+}
+
+Population::SteadyStateStats Population::evolve_steady_state(const GenomeFitnessFunction &fitness_fn,
+                                                             std::size_t num_evaluations, std::size_t num_threads) {
+    ThreadPool &pool = get_thread_pool(num_threads);
+    const std::size_t size = individuals.size();
+    if (size < pool.size() + 2) {
+        throw std::runtime_error("Erreur : Le mode continu demande au moins deux individus de plus que de threads.");
+    }
+
+    // État partagé, protégé par `mutex`. Un individu est soit à évaluer, soit en cours (remplacement
+    // compris), soit évalué et disponible comme parent ou victime.
+    std::mutex mutex;
+    std::set<std::pair<double, std::size_t>> ranked; // (fitness, index) des individus disponibles, du pire au meilleur
+    std::deque<std::size_t> unevaluated;
+    std::vector<char> available(size, 0);
+    std::size_t started = 0;
+    SteadyStateStats stats;
+
+    for (std::size_t i = 0; i < size; ++i) {
+        if (individuals[i].fitness_computed) {
+            ranked.emplace(individuals[i].fitness, i);
+            available[i] = 1;
+        } else {
+            unevaluated.push_back(i);
+        }
+    }
+
+    // Un flux par tâche : une tâche n'est exécutée que par un seul worker à la fois
+    std::vector<RNG> streams;
+    streams.reserve(pool.size());
+    for (std::size_t task = 0; task < pool.size(); ++task) {
+        streams.push_back(rng.split());
+    }
+
+    const int tournament_size = std::max(1, config.tournament_size);
+    auto tournament = [&](RNG &task_rng) {
+        std::size_t winner = size;
+        for (int round = 0; round < tournament_size;) {
+            std::size_t candidate = static_cast<std::size_t>(task_rng.next_int(0, static_cast<int>(size) - 1));
+            if (!available[candidate]) {
+                continue;
+            }
+            if (winner == size || individuals[candidate].fitness > individuals[winner].fitness) {
+                winner = candidate;
+            }
+            ++round;
+        }
+        return individuals[winner];
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    pool.parallel_for(pool.size(), [&](std::size_t task, std::size_t worker) {
+        RNG &task_rng = streams[task];
+        while (true) {
+            std::size_t slot;
+            std::shared_ptr<Genome> genome;
+            neat::Individual p1, p2;
+            int child_id = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (started >= num_evaluations) {
+                    return;
+                }
+                ++started;
+                if (!unevaluated.empty()) {
+                    slot = unevaluated.front();
+                    unevaluated.pop_front();
+                    genome = individuals[slot].genome;
+                } else {
+                    // Le plus mauvais individu disponible laisse sa place à un descendant des meilleurs
+                    slot = ranked.begin()->second;
+                    ranked.erase(ranked.begin());
+                    available[slot] = 0;
+                    p1 = tournament(task_rng);
+                    p2 = tournament(task_rng);
+                    child_id = generate_next_genome_id();
+                }
+            }
+
+            // Reproduction et évaluation hors du verrou
+            if (!genome) {
+                neat::Neat neat_instance(task_rng);
+                Genome offspring = neat_instance.crossover(p1, p2, child_id);
+                Mutator::mutate(offspring, config, task_rng, innovation_tracker);
+                genome = std::make_shared<Genome>(std::move(offspring));
+            }
+            const double fitness = fitness_fn(*genome, task_rng, worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            neat::Individual &individual = individuals[slot];
+            if (individual.genome != genome) {
+                individual = neat::Individual(genome);
+                ++stats.replacements;
+            }
+            individual.fitness = fitness;
+            individual.fitness_computed = true;
+            ranked.emplace(fitness, slot);
+            available[slot] = 1;
+            ++stats.evaluations;
+        }
+    });
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    update_best();
+    return stats;
+}
+
+double Population::SteadyStateStats::evaluations_per_second() const {
+    return seconds > 0.0 ? evaluations / seconds : 0.0;
+}
+
+void Population::SteadyStateStats::print(std::ostream &out) const {
+    out << "Mode continu : " << evaluations << " évaluations, " << replacements << " remplacements en "
+        << seconds << " s (" << evaluations_per_second() << " évaluations/s)" << std::endl;
+}
+
+double Population::PipelineStats::occupancy(double busy_seconds) const {
+    return seconds > 0.0 && workers > 0 ? busy_seconds / (seconds * workers) : 0.0;
+}
+
+void Population::PipelineStats::print(std::ostream &out) const {
+    out << "Pipeline : " << seconds * 1000.0 << " ms sur " << workers << " workers, occupation "
+        << "reproduction " << occupancy(reproduction_busy_seconds) * 100.0 << " %, "
+        << "évaluation " << occupancy(evaluation_busy_seconds) * 100.0 << " %" << std::endl;
+}
+
+const Population::PipelineStats &Population::get_pipeline_stats() const {
+    return pipeline_stats;
+}
+
+GenerationArena::Stats Population::get_arena_stats() const {
+    return arena ? arena->get_stats() : GenerationArena::Stats{};
+}
+
+GenomePool::Stats Population::get_genome_pool_stats() const {
+    return genome_pool ? genome_pool->get_stats() : GenomePool::Stats{};
+}
+
+std::shared_ptr<const Genome> Population::keep_alive(const neat::Individual &individual) {
+    if (!genome_pool || individual.handle == neat::no_genome_handle) {
+        return individual.genome;
+    }
+    // Le slot reste épinglé tant que le pointeur retourné (ou une de ses copies) existe
+    std::shared_ptr<GenomePool> pool = genome_pool;
+    const neat::GenomeHandle handle = individual.handle;
+    pool->pin(handle);
+    return std::shared_ptr<const Genome>(&(*pool)[handle], [pool, handle](const Genome *) { pool->unpin(handle); });
+}
+
+const FitnessCache &Population::get_fitness_cache() const {
+    return fitness_cache;
+}
+
+const Speciation &Population::get_speciation() const {
+    return speciation;
+}
+
+ThreadPool &Population::get_thread_pool(std::size_t num_threads) {
+    const std::size_t workers = ThreadPool::resolve_size(num_threads);
+    if (!thread_pool || thread_pool->size() != workers) {
+        thread_pool = std::make_unique<ThreadPool>(workers);
+    }
+    return *thread_pool;
+}
+
+std::vector<neat::Individual> Population::sort_individuals_by_fitness(const std::vector<neat::Individual>& individuals) {
+    std::vector<double> fitness(individuals.size());
+    for (std::size_t i = 0; i < individuals.size(); ++i) {
+        fitness[i] = individuals[i].fitness;
+    }
+
+    std::vector<neat::Individual> sorted_individuals;
+    sorted_individuals.reserve(individuals.size());
+    for (std::size_t index : rank_by_fitness(fitness)) {
+        sorted_individuals.push_back(individuals[index]);
+    }
     return sorted_individuals;
 }
 
+std::vector<std::size_t> Population::rank_by_fitness(const std::vector<double> &fitness) {
+    std::vector<std::size_t> ranking(fitness.size());
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::stable_sort(ranking.begin(), ranking.end(), [&fitness](std::size_t a, std::size_t b) {
+        return fitness[a] > fitness[b];
+    });
+    return ranking;
+}
+
 void Population::update_best() {
     auto best_it = std::max_element(individuals.begin(), individuals.end(), 
         [](const neat::Individual& a, const neat::Individual& b) {
@@ -134,6 +607,16 @@ void Population::replace_population(std::vector<neat::Individual> new_generation
 
     // Remplace les individus actuels par ceux de la nouvelle génération
     individuals = std::move(new_generation);
+    if (next_arena) {
+        arena = std::move(next_arena);
+    }
+    if (genome_pool) {
+        std::vector<neat::GenomeHandle> handles(individuals.size());
+        for (std::size_t i = 0; i < individuals.size(); ++i) {
+            handles[i] = individuals[i].handle;
+        }
+        genome_pool->set_generation(std::move(handles));
+    }
 
     // Met à jour le meilleur individu avec la nouvelle population
     update_best();
@@ -6,13 +6,62 @@
 #include "ComputeFitness.h"
 #include "Genome.h"
 #include "NeatConfig.h"
+#include "InnovationTracker.h"
+#include "ThreadPool.h"
+#include "FitnessCache.h"
+#include "ParentSelector.h"
+#include "Speciation.h"
+#include "GenerationArena.h"
+#include "GenomePool.h"
 #include <vector>
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <memory>
+#include <ostream>
 
 class Population
 {
 public:
+   /**
+    * @brief Fonction de fitness d'un individu pour `evaluate`.
+    *
+    * Elle reçoit l'index de l'individu dans la population, un flux aléatoire propre à cet individu
+    * et le numéro du worker qui l'exécute (dans [0, num_threads)), qui permet d'utiliser un
+    * environnement (par exemple un ComputeFitness) propre à chaque worker.
+    */
+   using FitnessFunction = std::function<double(std::size_t index, RNG &rng, std::size_t worker)>;
+
+   /**
+    * @brief Fonction de fitness d'un génome pour `evolve_steady_state`.
+    *
+    * En mode continu, la population change pendant les évaluations : la fonction reçoit directement
+    * le génome à évaluer plutôt qu'un index.
+    */
+   using GenomeFitnessFunction = std::function<double(const Genome &genome, RNG &rng, std::size_t worker)>;
+
+   // Statistiques d'une exécution en mode continu
+   struct SteadyStateStats
+   {
+      std::size_t evaluations = 0;
+      std::size_t replacements = 0; // Individus remplacés par un descendant
+      double seconds = 0.0;
+
+      double evaluations_per_second() const;
+      void print(std::ostream &out) const;
+   };
+
+   // Occupation des workers pendant la dernière reproduction (voir `reproduce_and_evaluate`)
+   struct PipelineStats
+   {
+      double seconds = 0.0;                   // Durée de l'étape
+      std::size_t workers = 0;
+      double reproduction_busy_seconds = 0.0; // Croisements et mutations, tous workers confondus
+      double evaluation_busy_seconds = 0.0;   // Évaluations des descendants, tous workers confondus
+
+      double occupancy(double busy_seconds) const; // Fraction du temps disponible des workers
+      void print(std::ostream &out) const;
+   };
 
    
    /**
@@ -44,6 +93,17 @@ public:
     */
    int generate_next_genome_id();
 
+   /**
+    * @brief Réserve un bloc d'identifiants de génome consécutifs.
+    *
+    * Utilisé pour produire une génération en parallèle : chaque descendant reçoit
+    * `premier identifiant + sa position` sans synchronisation entre threads.
+    *
+    * @param count Le nombre d'identifiants à réserver.
+    * @return Le premier identifiant du bloc.
+    */
+   int reserve_genome_ids(int count);
+
    /**
     * @brief Mute le génome en ajoutant ou en supprimant des liens et des neurones, et en modifiant les poids et les biais.
     *
@@ -62,21 +122,89 @@ public:
    /**
     * @brief Permet de reproduire la population actuelle en fonction de la fitness, de sélectionner les parents parmi les meilleurs individus
     *
-    * Cette méthode permet de reproduire la population actuelle en fonction de la fitness des individus. Les individus sont triés par ordre de fitness
-    * décroissante, puis les parents sont sélectionnés parmi les meilleurs individus en fonction d'un seuil de survie défini par la configuration NEAT.
+    * Cette méthode permet de reproduire la population actuelle en fonction de la fitness des individus. Les parents sont choisis par un
+    * ParentSelector selon la méthode `config.selection` (par défaut, tirage parmi les meilleurs individus en fonction du seuil de survie),
+    * sans trier ni copier la population. Si `config.speciation` est vrai, la population est d'abord répartie en espèces : chaque espèce
+    * reçoit un nombre de descendants proportionnel à sa fitness partagée, et les deux parents d'un descendant sont de la même espèce.
     * Les parents sont ensuite croisés pour créer de nouveaux individus, qui sont ensuite mutés pour introduire de la diversité.
+    * Les descendants sont produits en parallèle (`config.num_threads`), chacun avec son propre flux aléatoire ; leurs
+    * innovations sont numérotées dans l'ordre de la génération. Pour une graine donnée, le résultat ne dépend pas du
+    * nombre de threads.
+    * Les `config.elitism` meilleurs individus sont recopiés en tête de la nouvelle génération, avec leur fitness.
     *
     * @return std::vector<neat::Individual> Un vecteur contenant les nouveaux individus de la génération suivante.
     */
    std::vector<neat::Individual> reproduce();
 
+   /**
+    * @brief Produit la génération suivante et évalue chaque descendant dès sa naissance.
+    *
+    * Équivaut à `reproduce` suivi de l'évaluation de la nouvelle génération, sans barrière entre les deux :
+    * le worker qui produit un descendant l'évalue aussitôt, pendant que les autres produisent les suivants.
+    * La sélection des parents attend en revanche que toute la génération courante soit évaluée.
+    * La table de transposition est consultée comme dans `evaluate`, et ses statistiques décrivent la
+    * nouvelle génération. Les descendants reçoivent le flux aléatoire qui a servi à les produire.
+    *
+    * @param fitness_fn La fonction de fitness d'un génome.
+    * @param num_threads Le nombre de threads ; 0 pour autant que de cœurs disponibles.
+    * @return std::vector<neat::Individual> La nouvelle génération, dont toutes les fitness sont calculées.
+    */
+   std::vector<neat::Individual> reproduce_and_evaluate(const GenomeFitnessFunction &fitness_fn, std::size_t num_threads);
+
+   /**
+    * @brief Évalue la fitness de tous les individus en parallèle.
+    *
+    * Les individus sont répartis sur un pool de threads à vol de tâches. Avant l'évaluation, un flux
+    * aléatoire indépendant est dérivé pour chaque individu, dans l'ordre de la population : pour une
+    * graine donnée, les fitness obtenues sont identiques quel que soit le nombre de threads.
+    * Les résultats sont écrits dans `fitness` (et `fitness_computed`) une fois tous les calculs terminés.
+    *
+    * Seuls les individus dont `fitness_computed` est faux sont évalués. Si `config.fitness_cache_capacity` est
+    * non nul, la fitness d'un génome dont le contenu est déjà dans la table de transposition (ou apparaît
+    * plusieurs fois dans la population) est reprise sans appel à `fitness_fn`. Les statistiques de la table sont remises à zéro à chaque appel.
+    *
+    * @param fitness_fn La fonction de fitness, appelée une fois par individu.
+    * @param num_threads Le nombre de threads ; 0 pour autant que de cœurs disponibles.
+    */
+   void evaluate(const FitnessFunction &fitness_fn, std::size_t num_threads);
+
+   /**
+    * @brief Fait évoluer la population en mode continu (steady state, à la manière de rtNEAT).
+    *
+    * Il n'y a pas de frontière entre générations : chaque worker enchaîne les évaluations sans attendre
+    * les autres. Les individus dont la fitness n'est pas encore calculée sont évalués en premier ;
+    * ensuite, chaque fois qu'un worker est libre, le plus mauvais individu évalué est remplacé par
+    * un descendant de deux parents choisis par tournoi (`config.tournament_size`), que ce worker
+    * produit puis évalue aussitôt. Un individu en cours d'évaluation n'est ni remplacé ni choisi comme parent.
+    *
+    * Les choix de remplacement dépendent de l'ordre de fin des évaluations : avec plusieurs threads,
+    * deux exécutions de même graine peuvent diverger. Les descendants sont alloués sur le tas, y compris
+    * en mode GenomeStorage::Pool : les génomes du pool qu'ils remplacent sont libérés au prochain `replace_population`.
+    *
+    * @param fitness_fn La fonction de fitness.
+    * @param num_evaluations Le nombre total d'évaluations à effectuer.
+    * @param num_threads Le nombre de threads ; 0 pour autant que de cœurs disponibles.
+    * @return SteadyStateStats Le nombre d'évaluations, de remplacements et le débit obtenu.
+    */
+   SteadyStateStats evolve_steady_state(const GenomeFitnessFunction &fitness_fn, std::size_t num_evaluations, std::size_t num_threads);
+
+   /**
+    * @brief Produit une génération à partir d'une liste de génomes, sélectionnés selon leur fitness.
+    *
+    * La fitness de chaque génome est calculée une seule fois (en parallèle, `config.num_threads`),
+    * puis les parents sont choisis par un ParentSelector sur ces scores, sans copier les génomes.
+    *
+    * @param genomes Les génomes parents.
+    * @return std::vector<neat::Individual> Les individus de la nouvelle génération.
+    */
    std::vector<neat::Individual> reproduce_from_genomes(const std::vector<std::shared_ptr<Genome>>& genomes);
 
    /**
     * @brief Trie les individus par fitness en ordre décroissant.
     *
     * Cette méthode trie les individus par fitness en ordre décroissant, du plus grand au plus petit.
-    * Elle retourne un nouveau vecteur d'individus trié par fitness.
+    * Elle retourne un nouveau vecteur d'individus trié par fitness. Le tri porte sur les indices
+    * (voir `rank_by_fitness`) : chaque individu n'est copié qu'une fois, à sa place finale.
     *
     * @param individuals Un vecteur d'individus à trier.
     * @return Un nouveau vecteur d'individus trié par fitness.
@@ -99,18 +227,86 @@ public:
  * Cette méthode prend en entrée un vecteur de nouveaux individus, 
  * et met à jour la population en remplaçant les anciens individus 
  * par les nouveaux tout en conservant les informations nécessaires.
+ * Si la génération a été produite par `reproduce`, son arène devient l'arène courante ; celle de
+ * l'ancienne génération est libérée en bloc dès que ses derniers génomes disparaissent.
  *
  * @param new_generation Le vecteur contenant les nouveaux individus.
  */
    void replace_population(std::vector<neat::Individual> new_generation);
 
+   /**
+    * @brief Retourne la table de transposition des fitness et ses statistiques pour la dernière évaluation.
+    */
+   const FitnessCache &get_fitness_cache() const;
+
+   /**
+    * @brief Retourne les espèces de la dernière reproduction et les statistiques de la répartition.
+    */
+   const Speciation &get_speciation() const;
+
+   /**
+    * @brief Retourne l'occupation des workers pendant la dernière reproduction.
+    */
+   const PipelineStats &get_pipeline_stats() const;
+
+   /**
+    * @brief Retourne les statistiques de l'arène de la génération courante (nulles sans arène).
+    */
+   GenerationArena::Stats get_arena_stats() const;
+
+   /**
+    * @brief Retourne l'état du pool de génomes (nul hors du mode GenomeStorage::Pool).
+    */
+   GenomePool::Stats get_genome_pool_stats() const;
+
+   /**
+    * @brief Garde le génome d'un individu de la génération courante au-delà de cette génération.
+    *
+    * En mode GenomeStorage::Pool, `individual.genome` ne possède pas le génome : son slot est réutilisé
+    * dès qu'il ne fait plus partie de la population. Le pointeur retourné épingle le slot jusqu'à sa
+    * destruction (champion conservé, génome en attente de sauvegarde...). En mode Shared, il s'agit
+    * simplement de `individual.genome`.
+    *
+    * @param individual Un individu de la génération courante.
+    * @return std::shared_ptr<const Genome> Un pointeur qui garde le génome en vie.
+    */
+   std::shared_ptr<const Genome> keep_alive(const neat::Individual &individual);
+
    
 private:
    NeatConfig config;
    RNG &rng;
    int next_genome_id;
+   InnovationTracker innovation_tracker; // Numéros d'innovation partagés par toute la population
    std::vector<neat::Individual> individuals;
    neat::Individual best_individual;
+   std::unique_ptr<ThreadPool> thread_pool; // Créé à la première évaluation parallèle
+   FitnessCache fitness_cache;              // Fitness déjà calculées, par empreinte de contenu
+   Speciation speciation;                   // Espèces, conservées d'une génération à l'autre
+   PipelineStats pipeline_stats;
+   std::shared_ptr<GenerationArena> arena;      // Arène de la génération courante
+   std::shared_ptr<GenerationArena> next_arena; // Arène de la génération produite, en attente de replace_population
+   std::shared_ptr<GenomePool> genome_pool;     // Génomes de la population en mode GenomeStorage::Pool
+
+   // Appelée sur chaque descendant dès sa création, sur le worker qui l'a produit
+   using BirthHook = std::function<void(neat::Individual &offspring, RNG &rng, std::size_t worker)>;
+
+   /**
+    * @brief Produit la génération suivante (voir `reproduce`), en appelant `on_birth` sur chaque descendant.
+    */
+   std::vector<neat::Individual> breed(const BirthHook &on_birth, std::size_t num_threads);
+
+   ThreadPool &get_thread_pool(std::size_t num_threads);
+
+   /**
+    * @brief Classe des indices par fitness décroissante.
+    *
+    * À fitness égale, l'ordre d'origine est conservé.
+    *
+    * @param fitness La fitness de chaque élément.
+    * @return std::vector<std::size_t> Les indices des éléments, du meilleur au moins bon.
+    */
+   static std::vector<std::size_t> rank_by_fitness(const std::vector<double> &fitness);
 };
 
 #endif // POPULATION_H
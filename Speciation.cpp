@@ -0,0 +1,214 @@
+#include "Speciation.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+Speciation::Speciation(const NeatConfig &config) : config(config) {}
+
+double Speciation::compatibility_distance(const Genome &a, const Genome &b, const NeatConfig &config) {
+    const neat::LinkGenes &links_a = a.get_links();
+    const neat::LinkGenes &links_b = b.get_links();
+    std::size_t disjoint = 0;
+    std::size_t matching = 0;
+    double weight_difference = 0.0;
+
+    // Fusion sur les seules clés d'innovation ; les poids ne sont lus que pour les liens communs
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < links_a.size() && j < links_b.size()) {
+        const int key_a = neat::gene_key(links_a, i);
+        const int key_b = neat::gene_key(links_b, j);
+        if (key_a == key_b) {
+            ++matching;
+            weight_difference += std::fabs(neat::link_weight(links_a, i++) - neat::link_weight(links_b, j++));
+        } else if (key_a < key_b) {
+            ++disjoint;
+            ++i;
+        } else {
+            ++disjoint;
+            ++j;
+        }
+    }
+    const std::size_t excess = (links_a.size() - i) + (links_b.size() - j);
+
+    const double n = static_cast<double>(std::max<std::size_t>({links_a.size(), links_b.size(), 1}));
+    double distance = config.compatibility_excess_coefficient * excess / n
+                    + config.compatibility_disjoint_coefficient * disjoint / n;
+    if (matching > 0) {
+        distance += config.compatibility_weight_coefficient * weight_difference / matching;
+    }
+    return distance;
+}
+
+double Speciation::distance_lower_bound(const Genome &a, const Genome &b, const NeatConfig &config) {
+    const neat::LinkGenes &links_a = a.get_links();
+    const neat::LinkGenes &links_b = b.get_links();
+    const double n = static_cast<double>(std::max<std::size_t>({links_a.size(), links_b.size(), 1}));
+    if (links_a.empty() || links_b.empty()) {
+        return config.compatibility_excess_coefficient * (links_a.size() + links_b.size()) / n;
+    }
+
+    // Liens au-delà de la plus grande innovation de l'autre génome : exactement les liens en excès
+    auto count_beyond = [](const neat::LinkGenes &links, int innovation) {
+        std::size_t low = 0;
+        std::size_t high = links.size();
+        while (low < high) {
+            const std::size_t middle = low + (high - low) / 2;
+            if (neat::gene_key(links, middle) <= innovation) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return links.size() - low;
+    };
+    const std::size_t excess = count_beyond(links_a, neat::gene_key(links_b, links_b.size() - 1))
+                             + count_beyond(links_b, neat::gene_key(links_a, links_a.size() - 1));
+
+    // |n_a - n_b| <= excès + disjoints
+    const std::size_t difference = links_a.size() > links_b.size() ? links_a.size() - links_b.size()
+                                                                    : links_b.size() - links_a.size();
+    const std::size_t disjoint = difference > excess ? difference - excess : 0;
+    return (config.compatibility_excess_coefficient * excess + config.compatibility_disjoint_coefficient * disjoint) / n;
+}
+
+void Speciation::speciate(const std::vector<neat::Individual> &individuals, ThreadPool &pool) {
+    const std::size_t unassigned = std::numeric_limits<std::size_t>::max();
+    const double threshold = config.compatibility_threshold;
+    const std::size_t num_existing = species.size();
+    stats = Stats{};
+
+    for (std::size_t s = 0; s < num_existing; ++s) {
+        species[s].members.clear();
+    }
+
+    // Comparaison avec les espèces existantes, en parallèle ; compteurs propres à chaque worker
+    std::vector<std::size_t> assignment(individuals.size(), unassigned);
+    std::vector<double> distance(individuals.size(), 0.0);
+    std::vector<std::size_t> computations(pool.size(), 0);
+    std::vector<std::size_t> rejections(pool.size(), 0);
+    pool.parallel_for(individuals.size(), [&](std::size_t index, std::size_t worker) {
+        const Genome &genome = *individuals[index].genome;
+        for (std::size_t s = 0; s < num_existing; ++s) {
+            if (distance_lower_bound(genome, *species[s].representative, config) >= threshold) {
+                ++rejections[worker];
+                continue;
+            }
+            ++computations[worker];
+            double d = compatibility_distance(genome, *species[s].representative, config);
+            if (d < threshold) {
+                assignment[index] = s;
+                distance[index] = d;
+                return;
+            }
+        }
+    });
+    stats.distance_computations = std::accumulate(computations.begin(), computations.end(), std::size_t{0});
+    stats.bound_rejections = std::accumulate(rejections.begin(), rejections.end(), std::size_t{0});
+
+    // Individus sans espèce : comparés aux espèces fondées pendant cette génération, sinon nouvelle espèce
+    for (std::size_t index = 0; index < individuals.size(); ++index) {
+        if (assignment[index] != unassigned) {
+            continue;
+        }
+        const Genome &genome = *individuals[index].genome;
+        for (std::size_t s = num_existing; s < species.size(); ++s) {
+            if (distance_lower_bound(genome, *species[s].representative, config) >= threshold) {
+                ++stats.bound_rejections;
+                continue;
+            }
+            ++stats.distance_computations;
+            if (compatibility_distance(genome, *species[s].representative, config) < threshold) {
+                assignment[index] = s;
+                break;
+            }
+        }
+        if (assignment[index] == unassigned) {
+            Species founded;
+            founded.id = next_species_id++;
+            founded.representative = std::make_shared<const Genome>(*individuals[index].genome);
+            assignment[index] = species.size();
+            species.push_back(std::move(founded));
+            ++stats.new_species;
+        }
+    }
+
+    for (std::size_t index = 0; index < individuals.size(); ++index) {
+        species[assignment[index]].members.push_back(index);
+    }
+
+    // Nouveau représentant d'une espèce existante : le membre le plus proche de l'ancien
+    for (std::size_t s = 0; s < num_existing; ++s) {
+        const std::vector<std::size_t> &members = species[s].members;
+        if (!members.empty()) {
+            std::size_t closest = *std::min_element(members.begin(), members.end(),
+                [&distance](std::size_t a, std::size_t b) { return distance[a] < distance[b]; });
+            species[s].representative = std::make_shared<const Genome>(*individuals[closest].genome);
+        }
+    }
+
+    const std::size_t before = species.size();
+    species.erase(std::remove_if(species.begin(), species.end(),
+                                 [](const Species &s) { return s.members.empty(); }),
+                  species.end());
+    stats.extinct_species = before - species.size();
+    stats.num_species = species.size();
+}
+
+void Speciation::allocate_offspring(const std::vector<neat::Individual> &individuals, std::size_t total) {
+    if (species.empty()) {
+        return;
+    }
+
+    // Fitness décalée pour être positive, puis partagée entre les membres de l'espèce
+    double min_fitness = std::numeric_limits<double>::infinity();
+    for (const auto &individual : individuals) {
+        min_fitness = std::min(min_fitness, individual.fitness);
+    }
+    double total_adjusted = 0.0;
+    for (Species &s : species) {
+        s.adjusted_fitness = 0.0;
+        s.best_fitness = -std::numeric_limits<double>::infinity();
+        for (std::size_t index : s.members) {
+            s.adjusted_fitness += individuals[index].fitness - min_fitness;
+            s.best_fitness = std::max(s.best_fitness, individuals[index].fitness);
+        }
+        s.adjusted_fitness /= s.members.size();
+        total_adjusted += s.adjusted_fitness;
+    }
+
+    // Parts proportionnelles (à la taille des espèces si toutes les fitness sont égales), arrondies par plus fort reste
+    std::vector<double> remainders(species.size());
+    std::size_t allocated = 0;
+    for (std::size_t s = 0; s < species.size(); ++s) {
+        double share = total_adjusted > 0.0
+            ? species[s].adjusted_fitness / total_adjusted * total
+            : static_cast<double>(species[s].members.size()) / individuals.size() * total;
+        species[s].offspring = static_cast<std::size_t>(std::floor(share));
+        remainders[s] = share - species[s].offspring;
+        allocated += species[s].offspring;
+    }
+    std::vector<std::size_t> order(species.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&remainders](std::size_t a, std::size_t b) { return remainders[a] > remainders[b]; });
+    for (std::size_t k = 0; allocated < total; k = (k + 1) % order.size()) {
+        ++species[order[k]].offspring;
+        ++allocated;
+    }
+}
+
+const std::vector<Species> &Speciation::get_species() const {
+    return species;
+}
+
+const Speciation::Stats &Speciation::get_stats() const {
+    return stats;
+}
+
+void Speciation::Stats::print(std::ostream &out) const {
+    out << "Spéciation : " << num_species << " espèces (" << new_species << " nouvelles, "
+        << extinct_species << " éteintes), " << distance_computations << " distances calculées, "
+        << bound_rejections << " évitées par la borne" << std::endl;
+}
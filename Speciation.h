@@ -0,0 +1,107 @@
+#ifndef SPECIATION_H
+#define SPECIATION_H
+
+#include "neat.h"
+#include "Genome.h"
+#include "NeatConfig.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Espèce : groupe d'individus dont les génomes sont proches au sens de la distance de compatibilité.
+ */
+struct Species
+{
+    int id;
+    std::shared_ptr<const Genome> representative; // Copie du génome auquel les individus sont comparés
+    std::vector<std::size_t> members;             // Indices des individus dans la population
+    double adjusted_fitness = 0.0;                // Somme des fitness partagées des membres
+    double best_fitness = 0.0;
+    std::size_t offspring = 0;                    // Nombre de descendants attribués
+};
+
+/**
+ * @brief Répartit la population en espèces et leur attribue des descendants (partage de fitness).
+ *
+ * À chaque génération, chaque individu est placé dans la première espèce dont le représentant est
+ * à une distance inférieure à `config.compatibility_threshold`. Les individus sont comparés aux espèces
+ * existantes en parallèle ; ceux qui n'en trouvent aucune fondent de nouvelles espèces, en série et
+ * dans l'ordre de la population, pour que le résultat ne dépende pas du nombre de threads.
+ * Une borne inférieure de la distance, calculée à partir du nombre de liens et des liens en excès, évite
+ * la comparaison complète avec les espèces manifestement trop éloignées.
+ */
+class Speciation
+{
+public:
+    // Statistiques de la dernière répartition
+    struct Stats
+    {
+        std::size_t num_species = 0;
+        std::size_t new_species = 0;
+        std::size_t extinct_species = 0;
+        std::size_t distance_computations = 0; // Distances complètes calculées
+        std::size_t bound_rejections = 0;      // Comparaisons évitées grâce à la borne inférieure
+
+        void print(std::ostream &out) const;
+    };
+
+    explicit Speciation(const NeatConfig &config);
+
+    /**
+     * @brief Calcule la distance de compatibilité entre deux génomes.
+     *
+     * δ = c_excès · E / N + c_disjoint · D / N + c_poids · W̄, où E et D sont les nombres de liens en excès
+     * et disjoints, W̄ la différence moyenne de poids des liens communs et N le nombre de liens du plus
+     * grand génome (au moins 1). Les liens, triés par innovation, sont alignés en une seule fusion.
+     *
+     * @return double La distance de compatibilité.
+     */
+    static double compatibility_distance(const Genome &a, const Genome &b, const NeatConfig &config);
+
+    /**
+     * @brief Borne inférieure de la distance de compatibilité, en O(log N).
+     *
+     * Le nombre E de liens en excès est obtenu exactement par recherche dichotomique de la plus grande
+     * innovation de chaque génome dans les liens de l'autre ; au moins |n_a - n_b| - E liens sont alors
+     * disjoints. La différence de poids est minorée par 0.
+     */
+    static double distance_lower_bound(const Genome &a, const Genome &b, const NeatConfig &config);
+
+    /**
+     * @brief Répartit les individus en espèces et met à jour les représentants.
+     *
+     * Le nouveau représentant d'une espèce existante est celui de ses membres le plus proche de
+     * l'ancien. Les représentants sont des copies : ils ne retiennent pas l'arène de leur génération
+     * (voir GenerationArena). Les espèces vides disparaissent.
+     *
+     * @param individuals Les individus, dont la fitness doit être calculée.
+     * @param pool Le pool de threads utilisé pour les comparaisons.
+     */
+    void speciate(const std::vector<neat::Individual> &individuals, ThreadPool &pool);
+
+    /**
+     * @brief Partage la fitness au sein des espèces et répartit les descendants entre elles.
+     *
+     * La fitness partagée d'un individu est sa fitness (décalée pour être positive) divisée par la taille
+     * de son espèce. Chaque espèce reçoit une part de `total` proportionnelle à la somme des fitness partagées
+     * de ses membres (méthode du plus fort reste).
+     *
+     * @param individuals Les individus répartis par le dernier appel à `speciate`.
+     * @param total Le nombre de descendants à répartir.
+     */
+    void allocate_offspring(const std::vector<neat::Individual> &individuals, std::size_t total);
+
+    const std::vector<Species> &get_species() const;
+    const Stats &get_stats() const;
+
+private:
+    NeatConfig config;
+    std::vector<Species> species;
+    int next_species_id = 0;
+    Stats stats;
+};
+
+#endif // SPECIATION_H
@@ -0,0 +1,127 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(std::size_t num_threads) {
+    const std::size_t workers = resolve_size(num_threads);
+    for (std::size_t w = 0; w < workers; ++w) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (std::size_t w = 1; w < workers; ++w) {
+        threads.emplace_back(&ThreadPool::worker_loop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return queues.size();
+}
+
+std::size_t ThreadPool::resolve_size(std::size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    return num_threads == 0 ? 1 : num_threads;
+}
+
+void ThreadPool::parallel_for(std::size_t count, const std::function<void(std::size_t, std::size_t)> &task) {
+    if (count == 0) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // Répartition initiale en blocs contigus, rééquilibrée ensuite par le vol de tâches
+        const std::size_t workers = queues.size();
+        for (std::size_t w = 0; w < workers; ++w) {
+            std::lock_guard<std::mutex> queue_lock(queues[w]->mutex);
+            for (std::size_t index = w * count / workers; index < (w + 1) * count / workers; ++index) {
+                queues[w]->indices.push_back(index);
+            }
+        }
+        body = &task;
+        error = nullptr;
+        running = threads.size();
+        ++job;
+    }
+    wake.notify_all();
+
+    run_tasks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return running == 0; });
+    body = nullptr;
+    if (error) {
+        std::exception_ptr failure = error;
+        error = nullptr;
+        std::rethrow_exception(failure);
+    }
+}
+
+void ThreadPool::worker_loop(std::size_t worker) {
+    std::size_t seen_job = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || job != seen_job; });
+            if (stopping) {
+                return;
+            }
+            seen_job = job;
+        }
+
+        run_tasks(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--running == 0) {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run_tasks(std::size_t worker) {
+    std::size_t index;
+    while (pop_local(worker, index) || steal(worker, index)) {
+        try {
+            (*body)(index, worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+}
+
+bool ThreadPool::pop_local(std::size_t worker, std::size_t &index) {
+    WorkQueue &queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.indices.empty()) {
+        return false;
+    }
+    index = queue.indices.back();
+    queue.indices.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(std::size_t worker, std::size_t &index) {
+    const std::size_t workers = queues.size();
+    for (std::size_t offset = 1; offset < workers; ++offset) {
+        WorkQueue &victim = *queues[(worker + offset) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.indices.empty()) {
+            index = victim.indices.front();
+            victim.indices.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,90 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pool de threads à vol de tâches (work stealing) pour les boucles parallèles.
+ *
+ * Chaque worker possède sa propre file d'indices. Il traite sa file par la fin et, une fois vide,
+ * vole des indices au début de la file des autres workers : les individus coûteux à évaluer
+ * n'immobilisent donc pas un worker pendant que les autres attendent.
+ * Le thread appelant participe au calcul en tant que worker 0.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Construit un pool de `num_threads` workers (thread appelant compris).
+     *
+     * @param num_threads Le nombre de workers ; 0 pour autant que de cœurs disponibles.
+     */
+    explicit ThreadPool(std::size_t num_threads = 0);
+
+    /**
+     * @brief Arrête et rejoint les threads du pool.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Retourne le nombre de workers, thread appelant compris.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Convertit un nombre de threads demandé en nombre de workers effectif.
+     *
+     * @param num_threads Le nombre demandé ; 0 pour autant que de cœurs disponibles.
+     * @return std::size_t Le nombre de workers, au moins 1.
+     */
+    static std::size_t resolve_size(std::size_t num_threads);
+
+    /**
+     * @brief Exécute `body(index, worker)` pour chaque index de [0, count) et attend la fin.
+     *
+     * `worker` est le numéro du worker qui exécute l'appel, dans [0, size()) : il permet d'utiliser
+     * un état propre à chaque worker sans synchronisation. Si un appel lève une exception,
+     * les autres indices sont tout de même traités, puis la première exception est relancée.
+     *
+     * @param count Le nombre d'indices à traiter.
+     * @param body La tâche à exécuter pour chaque index.
+     */
+    void parallel_for(std::size_t count, const std::function<void(std::size_t index, std::size_t worker)> &body);
+
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::size_t> indices;
+    };
+
+    void worker_loop(std::size_t worker);
+    void run_tasks(std::size_t worker);
+    bool pop_local(std::size_t worker, std::size_t &index);
+    bool steal(std::size_t worker, std::size_t &index);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable wake;        // Réveille les workers au début d'un travail
+    std::condition_variable done;        // Signale la fin d'un travail au thread appelant
+    const std::function<void(std::size_t, std::size_t)> *body = nullptr;
+    std::size_t job = 0;                 // Numéro du travail en cours
+    std::size_t running = 0;             // Workers (hors appelant) encore occupés par le travail en cours
+    bool stopping = false;
+    std::exception_ptr error;
+};
+
+#endif // THREAD_POOL_H
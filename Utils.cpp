@@ -12,11 +12,21 @@
  * @param filename Le nom du fichier dans lequel sauvegarder le génome.
  */
 void save(const Genome &genome, const std::string &filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
+    if (!write_genome(genome, filename)) {
         std::cerr << "Error: Could not open file " << filename << " for writing." << std::endl;
         return;
     }
+    std::cout << "Genome saved to " << filename << std::endl;
+}
+
+/**
+ * @brief Écrit un génome dans un fichier sans rien afficher.
+ */
+bool write_genome(const Genome &genome, const std::string &filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
 
     // Sauvegarder les informations du génome dans le fichier
     file << "Genome ID: " << genome.get_genome_id() << "\n";
@@ -34,7 +44,7 @@ void save(const Genome &genome, const std::string &filename) {
     }
 
     file.close();
-    std::cout << "Genome saved to " << filename << std::endl;
+    return !file.fail();
 }
 
 /**
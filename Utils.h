@@ -18,6 +18,17 @@
  */
 void save(const Genome &genome, const std::string &filename);
 
+/**
+ * @brief Écrit un génome dans un fichier, au format de `save`, sans rien afficher.
+ *
+ * Pour les appelants qui rendent compte eux-mêmes des échecs (voir GenomeWriter).
+ *
+ * @param genome Le génome à sauvegarder.
+ * @param filename Le nom du fichier dans lequel sauvegarder le génome.
+ * @return false si le fichier n'a pas pu être ouvert ou écrit.
+ */
+bool write_genome(const Genome &genome, const std::string &filename);
+
 /*
 std::vector<double> get_game_state(int ant_id);
 void perform_actions(const std::vector<double>& actions, int ant_id);
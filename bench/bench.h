@@ -0,0 +1,134 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "Genome.h"
+#include "rng.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * Outils communs aux microbenchmarks de bench/ : chronométrage et génomes synthétiques.
+ *
+ * Chaque benchmark est un exécutable autonome (voir la cible `bench` du Makefile). Les génomes sont
+ * construits directement par add_neuron et add_link, sans passer par Genome::create_genome qui affiche
+ * chaque gène.
+ */
+namespace bench
+{
+    /**
+     * @brief Meilleur temps d'exécution de `run`, en secondes, sur plusieurs mesures.
+     *
+     * @param run L'opération à mesurer.
+     * @param repeats Le nombre de mesures.
+     */
+    template <typename Run>
+    double best_time(Run &&run, int repeats = 5)
+    {
+        double best = 0.0;
+        for (int r = 0; r < repeats; ++r)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            best = r == 0 ? elapsed : std::min(best, elapsed);
+        }
+        return best;
+    }
+
+    /**
+     * @brief Construit un génome acyclique aléatoire.
+     *
+     * Les neurones sont rangés dans l'ordre entrées, cachés, sorties ; chaque lien relie un neurone à un
+     * neurone placé plus loin dans cet ordre, ce qui exclut les cycles. Les numéros d'innovation suivent
+     * l'ordre de création des liens.
+     *
+     * @param num_links Le nombre de liens, borné par le nombre de paires possibles.
+     */
+    inline Genome random_genome(int num_inputs, int num_outputs, int num_hidden, std::size_t num_links, RNG &rng)
+    {
+        Genome genome(0, num_inputs, num_outputs);
+        const int num_neurons = num_inputs + num_hidden + num_outputs;
+
+        // Position dans l'ordre -> identifiant (entrées 0.., sorties ensuite, cachés après les sorties)
+        auto id_at = [&](int position)
+        {
+            if (position < num_inputs)
+            {
+                return position;
+            }
+            if (position < num_inputs + num_hidden)
+            {
+                return num_inputs + num_outputs + (position - num_inputs);
+            }
+            return num_inputs + (position - num_inputs - num_hidden);
+        };
+
+        for (int id = 0; id < num_neurons; ++id)
+        {
+            genome.add_neuron(neat::NeuronGene{id, rng.next_gaussian(0.0, 1.0), Activation(Activation::Type::Sigmoid)});
+        }
+
+        std::size_t max_links = 0;
+        for (int target = num_inputs; target < num_neurons; ++target)
+        {
+            max_links += static_cast<std::size_t>(std::min(target, num_inputs + num_hidden));
+        }
+        num_links = std::min(num_links, max_links);
+        genome.reserve(num_neurons, num_links);
+
+        std::set<std::pair<int, int>> used;
+        int innovation = 0;
+        while (used.size() < num_links)
+        {
+            const int target = rng.next_int(num_inputs, num_neurons - 1);
+            const int source = rng.next_int(0, std::min(target, num_inputs + num_hidden) - 1);
+            if (used.emplace(source, target).second)
+            {
+                genome.add_link(neat::LinkGene{neat::LinkId{id_at(source), id_at(target)}, rng.next_gaussian(0.0, 1.0), true, innovation++});
+            }
+        }
+        return genome;
+    }
+
+    /**
+     * @brief Construit une chaîne : entrée 0 -> caché 2 -> ... -> caché `length + 1` -> sortie 1.
+     *
+     * Le cas le plus profond possible pour le calcul des couches.
+     *
+     * @param reversed Numérote les liens de la sortie vers l'entrée, comme le font des divisions
+     *        successives du lien le plus proche de l'entrée.
+     */
+    inline Genome chain_genome(int length, bool reversed = false)
+    {
+        Genome genome(0, 1, 1);
+        std::vector<neat::LinkId> chain;
+        int previous = 0;
+        for (int i = 0; i < length; ++i)
+        {
+            chain.push_back(neat::LinkId{previous, 2 + i});
+            previous = 2 + i;
+        }
+        chain.push_back(neat::LinkId{previous, 1});
+        if (reversed)
+        {
+            std::reverse(chain.begin(), chain.end());
+        }
+
+        for (int id = 0; id < length + 2; ++id)
+        {
+            genome.add_neuron(neat::NeuronGene{id, 0.0, Activation(Activation::Type::Sigmoid)});
+        }
+        int innovation = 0;
+        for (const neat::LinkId &link_id : chain)
+        {
+            genome.add_link(neat::LinkGene{link_id, 0.5, true, innovation++});
+        }
+        return genome;
+    }
+} // namespace bench
+
+#endif // BENCH_H
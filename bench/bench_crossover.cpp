@@ -0,0 +1,122 @@
+// Recherche de gènes et croisement : index par identifiant contre l'ancienne recherche linéaire
+#include "bench.h"
+#include "neat.h"
+#include <cstdio>
+#include <memory>
+#include <optional>
+
+namespace
+{
+    // Anciens find_neuron et find_link : parcours des gènes jusqu'au bon identifiant
+    template <typename Neurons>
+    std::optional<neat::NeuronGene> scan_neuron(const Neurons &neurons, int neuron_id)
+    {
+        for (const auto &neuron : neurons)
+        {
+            if (neuron.neuron_id == neuron_id)
+            {
+                return neuron;
+            }
+        }
+        return std::nullopt;
+    }
+
+    template <typename Links>
+    std::optional<neat::LinkGene> scan_link(const Links &links, neat::LinkId link_id)
+    {
+        for (const auto &link : links)
+        {
+            if (link.link_id == link_id)
+            {
+                return link;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Ancien croisement : une recherche linéaire dans le parent récessif par gène du parent dominant
+    Genome scan_crossover(neat::Neat &neat_instance, const Genome &dominant, const Genome &recessive)
+    {
+        Genome offspring{1, dominant.get_num_inputs(), dominant.get_num_outputs()};
+        const auto &recessive_neurons = recessive.get_neurons();
+        const auto &recessive_links = recessive.get_links();
+        for (const auto &dominant_neuron : dominant.get_neurons())
+        {
+            std::optional<neat::NeuronGene> recessive_neuron = scan_neuron(recessive_neurons, dominant_neuron.neuron_id);
+            offspring.add_neuron(recessive_neuron ? neat_instance.crossover_neuron(dominant_neuron, *recessive_neuron) : neat::NeuronGene(dominant_neuron));
+        }
+        for (const auto &dominant_link : dominant.get_links())
+        {
+            std::optional<neat::LinkGene> recessive_link = scan_link(recessive_links, dominant_link.link_id);
+            offspring.add_link(recessive_link ? neat_instance.crossover_link(dominant_link, *recessive_link) : neat::LinkGene(dominant_link));
+        }
+        return offspring;
+    }
+} // namespace
+
+int main()
+{
+    RNG rng(8);
+    neat::Neat neat_instance(rng);
+
+    // Recherche de tous les liens du parent dominant, puis croisement complet
+    std::printf("%8s %14s %14s %9s %16s %16s %9s\n", "liens", "scan (µs)", "index (µs)", "rapport",
+                "ancien (µs)", "fusion (µs)", "rapport");
+    for (std::size_t num_links : {500, 2000, 5000})
+    {
+        // Deux parents de même lignée : le récessif a perdu un lien sur dix et ses poids diffèrent
+        const int num_hidden = static_cast<int>(num_links / 4);
+        auto dominant = std::make_shared<Genome>(bench::random_genome(8, 2, num_hidden, num_links, rng));
+        auto recessive = std::make_shared<Genome>(*dominant);
+        std::vector<neat::LinkId> removed;
+        for (std::size_t i = 0; i < dominant->get_links().size(); i += 10)
+        {
+            removed.push_back(dominant->get_links()[i].link_id);
+        }
+        for (const neat::LinkId &link_id : removed)
+        {
+            recessive->remove_link(link_id);
+        }
+        for (std::size_t i = 0; i < recessive->get_links().size(); ++i)
+        {
+            recessive->set_link_weight(i, rng.next_gaussian(0.0, 1.0));
+        }
+
+        // Recherche de chaque lien du parent dominant dans le parent récessif
+        std::size_t found = 0;
+        const auto &recessive_links = recessive->get_links();
+        const double scan_time = bench::best_time([&]
+        {
+            for (const auto &link : dominant->get_links())
+            {
+                found += scan_link(recessive_links, link.link_id).has_value();
+            }
+        }, 3);
+        const double index_time = bench::best_time([&]
+        {
+            for (const auto &link : dominant->get_links())
+            {
+                found += recessive->find_link(link.link_id).has_value();
+            }
+        }, 3);
+
+        std::size_t sink = 0;
+        const double old_crossover_time = bench::best_time([&]
+        {
+            sink += scan_crossover(neat_instance, *dominant, *recessive).get_links().size();
+        }, 3);
+        const double crossover_time = bench::best_time([&]
+        {
+            sink += neat_instance.alt_crossover(dominant, recessive, 1).get_links().size();
+        }, 3);
+
+        std::printf("%8zu %14.1f %14.1f %8.0fx %16.1f %16.1f %8.1fx\n", dominant->get_links().size(), scan_time * 1e6,
+                    index_time * 1e6, scan_time / index_time, old_crossover_time * 1e6, crossover_time * 1e6,
+                    old_crossover_time / crossover_time);
+        if (found == 0 || sink == 0)
+        {
+            std::printf("aucun gène commun\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+// Détection de cycles : ordre topologique incrémental contre l'ancien parcours sur un graphe reconstruit
+#include "bench.h"
+#include "InnovationTracker.h"
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // Ancien would_create_cycle : reconstruit le graphe des liens activés puis cherche un chemin de
+    // output_id vers input_id
+    bool scan_would_create_cycle(const Genome &genome, int input_id, int output_id)
+    {
+        std::unordered_set<int> visited;
+        std::unordered_map<int, std::vector<int>> graph;
+        for (const auto &link : genome.get_links())
+        {
+            if (link.is_enabled)
+            {
+                graph[link.link_id.input_id].push_back(link.link_id.output_id);
+            }
+        }
+
+        std::function<bool(int)> dfs = [&](int current)
+        {
+            if (current == input_id)
+            {
+                return true;
+            }
+            if (visited.count(current))
+            {
+                return false;
+            }
+            visited.insert(current);
+            for (int neighbor : graph[current])
+            {
+                if (dfs(neighbor))
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+        return dfs(output_id);
+    }
+
+    // Initialisation d'un génome comme Genome::create_genome (sans ses affichages) : entrées -> cachés,
+    // cachés -> cachés suivants, cachés -> sorties, chaque lien vérifié par `would_create_cycle`
+    template <typename CycleCheck>
+    Genome dense_genome(int num_inputs, int num_outputs, int num_hidden, RNG &rng, CycleCheck &&would_create_cycle)
+    {
+        InnovationTracker innovations;
+        Genome genome(0, num_inputs, num_outputs);
+        const int first_hidden = num_inputs + num_outputs;
+        const int end_hidden = first_hidden + num_hidden;
+        for (int id = 0; id < end_hidden; ++id)
+        {
+            genome.add_neuron(neat::NeuronGene{id, 0.0, Activation(Activation::Type::Sigmoid)});
+        }
+        auto connect = [&](int input_id, int output_id)
+        {
+            if (!would_create_cycle(genome, input_id, output_id))
+            {
+                genome.add_link(genome.create_link(input_id, output_id, rng, innovations));
+            }
+        };
+        for (int input_id = 0; input_id < num_inputs; ++input_id)
+        {
+            for (int hidden_id = first_hidden; hidden_id < end_hidden; ++hidden_id)
+            {
+                connect(input_id, hidden_id);
+            }
+        }
+        for (int hidden_id = first_hidden; hidden_id < end_hidden; ++hidden_id)
+        {
+            for (int target_id = hidden_id + 1; target_id < end_hidden; ++target_id)
+            {
+                connect(hidden_id, target_id);
+            }
+        }
+        for (int hidden_id = first_hidden; hidden_id < end_hidden; ++hidden_id)
+        {
+            for (int output_id = num_inputs; output_id < num_inputs + num_outputs; ++output_id)
+            {
+                connect(hidden_id, output_id);
+            }
+        }
+        return genome;
+    }
+} // namespace
+
+int main()
+{
+    RNG rng(11);
+
+    // Initialisation de la population : un génome entièrement connecté par taille de couche cachée
+    std::printf("Initialisation d'un génome\n");
+    std::printf("%8s %8s %14s %14s %9s\n", "cachés", "liens", "ancien (ms)", "ordre (ms)", "rapport");
+    for (int num_hidden : {25, 50, 100})
+    {
+        std::size_t num_links = 0;
+        const double scan_time = bench::best_time([&]
+        {
+            num_links = dense_genome(8, 2, num_hidden, rng, scan_would_create_cycle).get_links().size();
+        }, 3);
+        const double order_time = bench::best_time([&]
+        {
+            dense_genome(8, 2, num_hidden, rng, [](const Genome &genome, int input_id, int output_id)
+            {
+                return genome.would_create_cycle(input_id, output_id);
+            });
+        }, 3);
+        std::printf("%8d %8zu %14.2f %14.2f %8.0fx\n", num_hidden, num_links, scan_time * 1e3, order_time * 1e3, scan_time / order_time);
+    }
+
+    // Mutation d'ajout de lien sur un grand génome : une vérification par paire candidate, puis ajout
+    // du lien s'il est acyclique
+    std::printf("\nAjout de liens sur un grand génome (1000 candidats)\n");
+    std::printf("%8s %8s %14s %14s %9s\n", "cachés", "liens", "ancien (ms)", "ordre (ms)", "rapport");
+    for (int num_hidden : {250, 1000, 4000})
+    {
+        const Genome genome = bench::random_genome(8, 2, num_hidden, 4 * static_cast<std::size_t>(num_hidden), rng);
+        const int num_neurons = static_cast<int>(genome.get_neurons().size());
+
+        std::vector<std::pair<int, int>> candidates;
+        while (candidates.size() < 1000)
+        {
+            const int input_id = rng.next_int(0, num_neurons - 1);
+            const int output_id = rng.next_int(8, num_neurons - 1);
+            if (input_id != output_id && !genome.find_link(neat::LinkId{input_id, output_id}))
+            {
+                candidates.emplace_back(input_id, output_id);
+            }
+        }
+
+        // Les deux méthodes doivent donner les mêmes réponses
+        for (const auto &candidate : candidates)
+        {
+            if (scan_would_create_cycle(genome, candidate.first, candidate.second) !=
+                genome.would_create_cycle(candidate.first, candidate.second))
+            {
+                std::printf("Réponses différentes pour %d -> %d\n", candidate.first, candidate.second);
+                return 1;
+            }
+        }
+
+        auto add_links = [&](auto &&would_create_cycle)
+        {
+            Genome mutated = genome;
+            int innovation = static_cast<int>(genome.get_links().size());
+            for (const auto &candidate : candidates)
+            {
+                if (!would_create_cycle(mutated, candidate.first, candidate.second))
+                {
+                    mutated.add_link(neat::LinkGene{neat::LinkId{candidate.first, candidate.second}, 0.5, true, innovation++});
+                }
+            }
+            return mutated.get_links().size();
+        };
+        std::size_t sink = 0;
+        const double scan_time = bench::best_time([&] { sink += add_links(scan_would_create_cycle); }, 3);
+        const double order_time = bench::best_time([&]
+        {
+            sink += add_links([](const Genome &mutated, int input_id, int output_id)
+            {
+                return mutated.would_create_cycle(input_id, output_id);
+            });
+        }, 3);
+        std::printf("%8d %8zu %14.2f %14.2f %8.0fx\n", num_hidden, genome.get_links().size(), scan_time * 1e3,
+                    order_time * 1e3, scan_time / order_time);
+        if (sink == 0)
+        {
+            std::printf("aucun lien\n");
+        }
+    }
+    return 0;
+}
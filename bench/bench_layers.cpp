@@ -0,0 +1,127 @@
+// Calcul des couches : tri topologique de Kahn contre l'ancienne recherche couche par couche
+#include "bench.h"
+#include "LayerManager.h"
+#include <cstdio>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // Ancien organize_layers : un parcours complet des liens par couche
+    template <typename Links>
+    std::vector<std::vector<int>> scan_layers(const std::vector<int> &inputs, const std::vector<int> &outputs, const Links &links)
+    {
+        std::unordered_set<int> known_neurons(inputs.begin(), inputs.end());
+        std::unordered_set<int> output_neurons(outputs.begin(), outputs.end());
+        std::vector<std::vector<int>> layers;
+        layers.push_back(inputs);
+
+        bool added_new_layer = true;
+        while (added_new_layer)
+        {
+            added_new_layer = false;
+            std::vector<int> new_layer;
+            for (const auto &link : links)
+            {
+                if (known_neurons.count(link.link_id.input_id) && !known_neurons.count(link.link_id.output_id) &&
+                    !output_neurons.count(link.link_id.output_id))
+                {
+                    new_layer.push_back(link.link_id.output_id);
+                    known_neurons.insert(link.link_id.output_id);
+                    added_new_layer = true;
+                }
+            }
+            if (!new_layer.empty())
+            {
+                layers.push_back(new_layer);
+            }
+            if (layers.size() > links.size() + inputs.size() + outputs.size())
+            {
+                throw std::runtime_error("cycle");
+            }
+        }
+        layers.push_back(outputs);
+        return layers;
+    }
+
+    // Ancien sort_by_layer : point fixe sur tous les liens, appelé pour chaque couche
+    template <typename Links>
+    std::vector<int> fixed_point_sort(const std::vector<int> &layer, const Links &links)
+    {
+        std::unordered_map<int, int> neuron_layers;
+        for (int neuron : layer)
+        {
+            neuron_layers[neuron] = 0;
+        }
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (const auto &link : links)
+            {
+                if (neuron_layers.count(link.link_id.input_id))
+                {
+                    int expected = neuron_layers[link.link_id.input_id] + 1;
+                    if (!neuron_layers.count(link.link_id.output_id) || neuron_layers[link.link_id.output_id] < expected)
+                    {
+                        neuron_layers[link.link_id.output_id] = expected;
+                        changed = true;
+                    }
+                }
+            }
+        }
+        std::vector<int> sorted_layer = layer;
+        std::sort(sorted_layer.begin(), sorted_layer.end(), [&](int a, int b) { return neuron_layers[a] < neuron_layers[b]; });
+        return sorted_layer;
+    }
+
+    void run(const char *name, const Genome &genome)
+    {
+        const std::vector<int> inputs = genome.make_input_ids();
+        const std::vector<int> outputs = genome.make_output_ids();
+        const auto &links = genome.get_links();
+
+        std::size_t sink = 0;
+        const double old_time = bench::best_time([&]
+        {
+            for (const auto &layer : scan_layers(inputs, outputs, links))
+            {
+                sink += fixed_point_sort(layer, links).size();
+            }
+        }, 3);
+        const double kahn_time = bench::best_time([&]
+        {
+            sink += LayerManager::organize_layers(inputs, outputs, links).size();
+        }, 3);
+
+        std::printf("%-22s %8zu %8zu %12.3f %12.3f %8.0fx\n", name, genome.get_neurons().size(), links.size(),
+                    old_time * 1e3, kahn_time * 1e3, old_time / kahn_time);
+        if (sink == 0)
+        {
+            std::printf("aucune couche\n");
+        }
+    }
+} // namespace
+
+int main()
+{
+    RNG rng(5);
+    std::printf("%-22s %8s %8s %12s %12s %9s\n", "génome", "neurones", "liens", "ancien (ms)", "Kahn (ms)", "rapport");
+    for (int hidden : {100, 1000, 3000})
+    {
+        const std::string name = "aléatoire " + std::to_string(hidden) + " cachés";
+        run(name.c_str(), bench::random_genome(8, 2, hidden, 4 * static_cast<std::size_t>(hidden), rng));
+    }
+    for (int length : {100, 1000, 3000})
+    {
+        run(("chaîne " + std::to_string(length)).c_str(), bench::chain_genome(length));
+    }
+    // L'ancien calcul est cubique sur une chaîne inversée : longueurs limitées
+    for (int length : {100, 200, 400})
+    {
+        run(("chaîne inversée " + std::to_string(length)).c_str(), bench::chain_genome(length, true));
+    }
+    return 0;
+}
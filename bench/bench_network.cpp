@@ -0,0 +1,128 @@
+// Activation d'un réseau : programme compilé à slots denses contre l'ancienne évaluation par table de hachage
+#include "bench.h"
+#include "NeuralNetwork.h"
+#include "LayerManager.h"
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+    // Ancienne représentation : neurones dans l'ordre topologique, valeurs dans une table recréée à chaque appel
+    struct MapNetwork
+    {
+        std::vector<int> input_ids;
+        std::vector<int> output_ids;
+        std::vector<Neuron> neurons;
+
+        std::vector<double> activate(const std::vector<double> &inputs) const
+        {
+            std::unordered_map<int, double> values;
+            for (std::size_t i = 0; i < inputs.size(); i++)
+            {
+                values[input_ids[i]] = inputs[i];
+            }
+            for (int output_id : output_ids)
+            {
+                values[output_id] = 0.0;
+            }
+            for (const auto &neuron : neurons)
+            {
+                double value = neuron.bias;
+                for (const NeuronInput &input : neuron.inputs)
+                {
+                    value += values[input.input_id] * input.weight;
+                }
+                values[neuron.neuron_id] = std::visit([value](auto &&fn) { return fn(value); }, neuron.activation);
+            }
+            std::vector<double> outputs;
+            for (int output_id : output_ids)
+            {
+                outputs.push_back(values[output_id]);
+            }
+            return outputs;
+        }
+    };
+
+    MapNetwork make_map_network(const Genome &genome)
+    {
+        MapNetwork network{genome.make_input_ids(), genome.make_output_ids(), {}};
+        const std::unordered_set<int> input_set(network.input_ids.begin(), network.input_ids.end());
+        for (const auto &layer : LayerManager::organize_layers(network.input_ids, network.output_ids, genome.get_links()))
+        {
+            for (int neuron_id : LayerManager::sort_by_layer(layer, genome.get_links()))
+            {
+                if (input_set.count(neuron_id))
+                {
+                    continue;
+                }
+                Neuron neuron{neuron_id, convert_activation(genome.find_neuron(neuron_id)->activation), genome.find_neuron(neuron_id)->bias, {}};
+                for (const auto &link : genome.get_links())
+                {
+                    if (link.is_enabled && link.link_id.output_id == neuron_id)
+                    {
+                        neuron.inputs.push_back(NeuronInput{link.link_id.input_id, link.weight});
+                    }
+                }
+                network.neurons.push_back(std::move(neuron));
+            }
+        }
+        return network;
+    }
+} // namespace
+
+int main()
+{
+    const int num_inputs = 8;
+    const int num_outputs = 2;
+    RNG rng(1);
+
+    std::printf("%8s %16s %16s %9s\n", "liens", "table (ns/appel)", "slots (ns/appel)", "rapport");
+    for (std::size_t num_links : {10, 100, 1000, 10000})
+    {
+        const int num_hidden = static_cast<int>(std::max<std::size_t>(2, num_links / 8));
+        Genome genome = bench::random_genome(num_inputs, num_outputs, num_hidden, num_links, rng);
+
+        MapNetwork map_network = make_map_network(genome);
+        FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(genome);
+
+        std::vector<double> inputs(num_inputs);
+        rng.fill_uniform(inputs.data(), inputs.size(), -1.0, 1.0);
+        std::vector<double> outputs;
+
+        // Les deux chemins doivent donner le même résultat
+        network.activate(inputs, outputs);
+        const std::vector<double> expected = map_network.activate(inputs);
+        for (std::size_t o = 0; o < outputs.size(); ++o)
+        {
+            if (std::fabs(outputs[o] - expected[o]) > 1e-12)
+            {
+                std::printf("Sorties différentes pour %zu liens\n", num_links);
+                return 1;
+            }
+        }
+
+        const int calls = static_cast<int>(std::max<std::size_t>(10, 2000000 / num_links));
+        volatile double sink = 0.0; // Empêche l'élimination des appels mesurés
+        const double map_time = bench::best_time([&]
+        {
+            for (int c = 0; c < calls; ++c)
+            {
+                sink += map_network.activate(inputs)[0];
+            }
+        });
+        const double slot_time = bench::best_time([&]
+        {
+            for (int c = 0; c < calls; ++c)
+            {
+                network.activate(inputs, outputs);
+                sink += outputs[0];
+            }
+        });
+
+        std::printf("%8zu %16.0f %16.0f %8.1fx\n", genome.get_links().size(), map_time / calls * 1e9, slot_time / calls * 1e9,
+                    map_time / slot_time);
+    }
+    return 0;
+}
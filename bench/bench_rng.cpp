@@ -0,0 +1,146 @@
+// Débit du générateur : remplissages en bloc contre les distributions de <random>
+#include "bench.h"
+#include "Mutator.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t samples = 1 << 20;
+
+    void print(const char *name, double seconds)
+    {
+        std::printf("%-44s %10.1f Mtirages/s %8.2f ns/tirage\n", name, samples / seconds * 1e-6, seconds / samples * 1e9);
+    }
+} // namespace
+
+int main()
+{
+    std::vector<double> values(samples);
+    volatile double sink = 0.0; // Empêche l'élimination des tirages mesurés
+
+    // Gaussiennes : l'ancien next_gaussian construisait une distribution par tirage
+    {
+        Xoshiro256pp engine(13);
+        print("std::normal_distribution par tirage", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                std::normal_distribution<double> normal(0.0, 1.0);
+                value = normal(engine);
+            }
+            sink += values.back();
+        }));
+    }
+    {
+        std::mt19937_64 engine(13);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        print("std::normal_distribution + mt19937_64", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                value = normal(engine);
+            }
+            sink += values.back();
+        }));
+    }
+    {
+        Xoshiro256pp engine(13);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        print("std::normal_distribution + xoshiro256++", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                value = normal(engine);
+            }
+            sink += values.back();
+        }));
+    }
+    {
+        RNG rng(13);
+        print("RNG::next_gaussian", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                value = rng.next_gaussian(0.0, 1.0);
+            }
+            sink += values.back();
+        }));
+        print("RNG::fill_gaussian", bench::best_time([&]
+        {
+            rng.fill_gaussian(values.data(), values.size());
+            sink += values.back();
+        }));
+    }
+
+    // Perturbation des poids : un delta par appel, ou tous les deltas d'un coup
+    {
+        RNG rng(13);
+        print("mutate_delta par poids", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                value = mutate_delta(value, rng);
+            }
+            sink += values.back();
+        }));
+        print("mutate_deltas", bench::best_time([&]
+        {
+            mutate_deltas(values.data(), values.size(), rng);
+            sink += values.back();
+        }));
+    }
+
+    // Uniformes
+    {
+        std::mt19937_64 engine(13);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+        print("std::uniform_real_distribution + mt19937_64", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                value = uniform(engine);
+            }
+            sink += values.back();
+        }));
+    }
+    {
+        RNG rng(13);
+        print("RNG::next_double", bench::best_time([&]
+        {
+            for (double &value : values)
+            {
+                value = rng.next_double();
+            }
+            sink += values.back();
+        }));
+        print("RNG::fill_uniform", bench::best_time([&]
+        {
+            rng.fill_uniform(values.data(), values.size());
+            sink += values.back();
+        }));
+    }
+
+    // Découpage : un flux par génome ou par thread, sans recopier la réserve de normales
+    {
+        RNG rng(13);
+        rng.next_gaussian(0.0, 1.0);
+        print("RNG::split + un tirage", bench::best_time([&]
+        {
+            for (std::size_t i = 0; i < samples; ++i)
+            {
+                sink += rng.split().next_double();
+            }
+        }));
+        print("copie d'un RNG, réserve comprise, + un tirage", bench::best_time([&]
+        {
+            for (std::size_t i = 0; i < samples; ++i)
+            {
+                RNG copy(rng);
+                sink += copy.next_double();
+            }
+        }));
+    }
+    return 0;
+}
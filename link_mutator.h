@@ -18,9 +18,9 @@ namespace neat
          * entre les neurones dans un réseau de neurones. Elle utilise un générateur de nombres
          * aléatoires (RNG) pour introduire des variations dans les propriétés des liens.
          *
-         * @note Le constructeur par défaut initialise le générateur de nombres aléatoires.
+         * @param rng Le générateur de nombres aléatoires à utiliser ; il doit survivre au LinkMutator.
          */
-        LinkMutator() : rng() {}
+        explicit LinkMutator(RNG &rng) : rng(rng) {}
 
         /**
          * @brief Crée un nouveau LinkGene avec les ID d'entrée et de sortie spécifiés.
@@ -50,20 +50,19 @@ namespace neat
     }
 
     private:
-        RNG rng;
+        RNG &rng;
 
         /**
          * @brief Génère un poids aléatoire.
          *
          * Cette fonction génère une valeur double aléatoire entre -1.0 et 1.0.
-         * Elle utilise la fonction de la bibliothèque standard rand() pour produire un nombre aléatoire,
-         * l'échelle à la plage [0, 1], puis le transforme à la plage [-1, 1].
+         * Elle tire un réel uniforme dans [0, 1) avec le RNG partagé, puis le transforme à la plage [-1, 1).
          *
          * @return Une valeur double aléatoire entre -1.0 et 1.0.
          */
         double generate_random_weight()
         {
-            return ((double)rand() / RAND_MAX) * 2.0 - 1.0;
+            return rng.next_double() * 2.0 - 1.0;
         }
     };
 
@@ -3,6 +3,7 @@
 #include "NeuralNetwork.h"
 #include "Utils.h"
 #include "NeatConfig.h"
+#include "GenomeWriter.h"
 #include <iostream>
 
 
@@ -30,72 +31,112 @@ int main() {
     }
 }
 
-    ComputeFitness compute_fitness(rng);
+    // Un objet de calcul de fitness (et donc un cache de réseaux) par thread d'évaluation
+    // Leurs flux sont découpés d'un flux dédié (RNG::split) : ils ne reproduisent pas le flux de la
+    // population, et le nombre de threads n'influe pas sur celui-ci
+    const std::size_t num_threads = ThreadPool::resolve_size(config.num_threads);
+    RNG fitness_rng = rng.split();
+    std::vector<ComputeFitness> fitness_workers;
+    for (std::size_t worker = 0; worker < num_threads; ++worker) {
+        fitness_workers.emplace_back(fitness_rng);
+    }
 
 
     const int num_generations = 5;
     const int num_ants = 10;
 
-    for (int generation = 0; generation < num_generations; ++generation) {
-        std::cout << "Génération " << generation + 1 << " : " << std::endl;
+    // Simulation d'un individu : chaque thread utilise son propre objet de calcul de fitness,
+    // et chaque individu son propre flux aléatoire
+    auto simulate = [&](const Genome &genome, RNG &individual_rng, std::size_t worker) {
+        ComputeFitness &worker_fitness = fitness_workers[worker];
 
-        // Initialisation des fitness
-        for (auto &individual : population.get_individuals()) {
-            individual.fitness = 0.0;
-        }
-           
+        // 1. Récupérer le réseau neuronal de cet individu (compilé une seule fois par génome)
+        FeedForwardNeuralNetwork &network = worker_fitness.get_network_cache().get(genome);
 
-        // Simulation pour chaque fourmi
+        double fitness = 0.0;
         for (int ant_id = 0; ant_id < num_ants; ++ant_id) {
-            for (auto &individual : population.get_individuals()) {
-                // 1. Créer un réseau neuronal pour cet individu
-                FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(*individual.genome);
+            // 2. Obtenir l'état initial de la simulation pour cette fourmi
+            std::vector<double> game_state = default_get_game_state(ant_id, individual_rng);
+
+            // 3. Activer le réseau avec l'état de jeu
+            std::vector<double> actions = network.activate(game_state);
 
-               
+            // 4. Exécuter les actions dans l'environnement
+            default_perform_action(actions,ant_id);
 
-                // 2. Obtenir l'état initial de la simulation pour cette fourmi
-                std::vector<double> game_state = default_get_game_state(ant_id,rng);
+            // 5. Évaluer la fitness de cet individu pour cette fourmi
+            fitness += worker_fitness(genome, ant_id);
+        }
+        return fitness;
+    };
 
-                // 3. Activer le réseau avec l'état de jeu
-                std::vector<double> actions = network.activate(game_state);
+    // Les génomes sont sauvegardés en arrière-plan, pendant que l'évolution continue
+    GenomeWriter genome_writer;
 
-                // 4. Exécuter les actions dans l'environnement
-                default_perform_action(actions,ant_id);
+    // Seule la première génération est évaluée à part : les suivantes le sont au fil de leur production
+    population.evaluate([&](std::size_t index, RNG &individual_rng, std::size_t worker) {
+        return simulate(*population.get_individuals()[index].genome, individual_rng, worker);
+    }, num_threads);
 
-                // 5. Évaluer la fitness de cet individu pour cette fourmi
-                individual.fitness += compute_fitness(*individual.genome, ant_id);
-            }
+    for (int generation = 0; generation < num_generations; ++generation) {
+        std::cout << "Génération " << generation + 1 << " : " << std::endl;
+        population.get_fitness_cache().get_stats().print(std::cout);
+
+        // Statistiques des caches de réseaux pour cette génération (tous threads confondus)
+        std::size_t cache_hits = 0, cache_patches = 0, cache_misses = 0;
+        for (const auto &worker : fitness_workers) {
+            const NetworkCache &network_cache = worker.get_network_cache();
+            cache_hits += network_cache.hits();
+            cache_patches += network_cache.patches();
+            cache_misses += network_cache.misses();
+        }
+        std::cout << "Cache de réseaux : " << cache_hits << " succès, "
+                  << cache_patches << " corrigés, "
+                  << cache_misses << " compilés" << std::endl;
+        for (auto &worker : fitness_workers) {
+            worker.get_network_cache().reset_counters();
         }
 
         // Sauvegarde des génomes pour suivi
         int individual_index = 0;
         for (const auto &individual : population.get_individuals()) {
-            save(*individual.genome, "genome_saves/genome_generation_" 
-                                     + std::to_string(generation) 
-                                     + "_individual_" 
-                                     + std::to_string(individual_index++) + ".txt");
+            genome_writer.save(population.keep_alive(individual), "genome_saves/genome_generation_" 
+                                                  + std::to_string(generation) 
+                                                  + "_individual_" 
+                                                  + std::to_string(individual_index++) + ".txt");
         }
 
         // Mise à jour du meilleur individu
         population.update_best();
 
-        // Génération de la nouvelle population
-        auto new_generation = population.reproduce();
+        // Génération de la nouvelle population : chaque descendant est évalué dès sa production
+        auto new_generation = population.reproduce_and_evaluate(simulate, num_threads);
         if (new_generation.empty()) {
             throw std::runtime_error("Erreur : La génération produite est vide !");
         }
+        population.get_speciation().get_stats().print(std::cout);
+        population.get_pipeline_stats().print(std::cout);
+        genome_writer.get_stats().print(std::cout);
+        genome_writer.reset_stats();
 
         population.replace_population(std::move(new_generation));
+        population.get_arena_stats().print(std::cout);
+
+        // Les réseaux des génomes de l'ancienne génération ne serviront plus
+        for (auto &worker : fitness_workers) {
+            worker.get_network_cache().retain(population.get_individuals());
+        }
 
         // Affiche la meilleure fitness de la génération
         std::cout << "Meilleure fitness : " << population.get_individuals().front().fitness << std::endl;
 
         // Sauvegarde du meilleur génome
-        save(*population.get_individuals().front().genome, "best_genome_generation_" + std::to_string(generation + 1) + ".txt");
+        genome_writer.save(population.keep_alive(population.get_individuals().front()), "best_genome_generation_" + std::to_string(generation + 1) + ".txt");
     }
+    genome_writer.flush();
 
     // Réseau neuronal à partir du meilleur génome
-    auto best_genome = population.get_individuals().front().genome;
+    auto best_genome = population.keep_alive(population.get_individuals().front());
     FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(*best_genome);
 
     std::vector<double> inputs = { 0.5, 0.3, 0.8 };
@@ -3,11 +3,15 @@
 #include "NeuralNetwork.h"
 #include "Utils.h"
 #include "NeatConfig.h"
+#include "GenomeWriter.h"
 #include <iostream>
+#include <utility>
+#include <vector>
 
 int main() {
     RNG rng;
     NeatConfig config;
+    config.fitness_cache_capacity = 4096; // Partie déterministe : la fitness ne dépend que du génome
     Population population(config, rng);
 
     // Affichage initial des génomes
@@ -30,56 +34,104 @@ int main() {
         }
     }
 
-    // Créer l'objet de calcul de fitness
-    ComputeFitness compute_fitness(rng);
+    // Un objet de calcul de fitness (et donc un cache de réseaux) par thread d'évaluation
+    // Leurs flux sont découpés d'un flux dédié (RNG::split) : ils ne reproduisent pas le flux de la
+    // population, et le nombre de threads n'influe pas sur celui-ci
+    const std::size_t num_threads = ThreadPool::resolve_size(config.num_threads);
+    RNG fitness_rng = rng.split();
+    std::vector<ComputeFitness> fitness_workers;
+    for (std::size_t worker = 0; worker < num_threads; ++worker) {
+        fitness_workers.emplace_back(fitness_rng);
+    }
+    ComputeFitness &compute_fitness = fitness_workers.front();
 
     const int num_generations = 5;
     const int num_rounds = 10;  // Nombre de rounds pour chaque simulation
     const int num_ants = 10;    // Nombre d'individus dans chaque génération
 
+    // Les génomes sont sauvegardés en arrière-plan, pendant que l'évolution continue
+    GenomeWriter genome_writer;
+
     for (int generation = 0; generation < num_generations; ++generation) {
         std::cout << "Génération " << generation + 1 << " : " << std::endl;
 
-        // Initialisation des fitness
-        for (auto &individual : population.get_individuals()) {
-            individual.fitness = 0.0;
-        }
+        // Score pierre-papier-ciseaux de chaque individu, calculé une seule fois par topologie
+        GroupedEvaluator rpc_evaluator = compute_fitness.make_rpc_evaluator();
+        std::vector<double> rpc_scores = rpc_evaluator.evaluate(population.get_individuals(), /* measure_speedup */ true);
+        rpc_evaluator.get_stats().print(std::cout);
+
+        // Fitness cumulée après chaque round, par individu : chaque tâche n'écrit que sa propre case,
+        // affichée après l'évaluation
+        std::vector<std::vector<std::pair<int, double>>> round_fitness(population.get_individuals().size());
+
+        // Simulation de chaque individu, en parallèle : chaque thread utilise son propre objet de
+        // calcul de fitness, et chaque individu son propre flux aléatoire
+        population.evaluate([&](std::size_t index, RNG &individual_rng, std::size_t worker) {
+            const Genome &genome = *population.get_individuals()[index].genome;
+            std::vector<std::pair<int, double>> &trace = round_fitness[index];
+
+            // 1. Récupérer le réseau neuronal de cet individu (compilé une seule fois par génome)
+            FeedForwardNeuralNetwork &network = fitness_workers[worker].get_network_cache().get(genome);
+            const std::size_t num_actions = network.num_outputs();
+
+            double fitness = 0.0;
+            for (int ant_id = 0; ant_id < num_ants; ++ant_id) {
+                // 2. Obtenir les états de jeu de tous les rounds (choix aléatoires de l'adversaire)
+                std::vector<double> game_states;
+                for (int round = 0; round < num_rounds; ++round) {
+                    std::vector<double> game_state = get_game_state_rpc(ant_id, individual_rng);
+                    game_states.insert(game_states.end(), game_state.begin(), game_state.end());
+                }
 
-        // Simulation pour chaque individu
-        for (int ant_id = 0; ant_id < num_ants; ++ant_id) {
-            for (auto &individual : population.get_individuals()) {
-                // 1. Créer un réseau neuronal pour cet individu
-                FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(*individual.genome);
+                // 3. Activer le réseau sur tous les rounds en un seul passage (choix de l'individu)
+                std::vector<double> all_actions = network.activate_batch(game_states, num_rounds);
 
-                // 2. Simuler les rounds de pierre-papier-ciseaux
+                // 4. Simuler les rounds de pierre-papier-ciseaux
                 for (int round = 0; round < num_rounds; ++round) {
-                    // 3. Obtenir l'état de jeu (choix aléatoire de l'adversaire)
-                    std::vector<double> game_state = get_game_state_rpc(ant_id, rng);
-
-                    // 4. Activer le réseau avec l'état de jeu (choix de l'individu)
-                    std::vector<double> actions = network.activate(game_state);
+                    std::vector<double> actions(all_actions.begin() + round * num_actions,
+                                                all_actions.begin() + (round + 1) * num_actions);
 
                     // 5. Exécuter l'action du réseau
                     perform_action_rpc(actions, ant_id);
 
                     // 6. Évaluer la fitness de l'individu pour ce round
-                    individual.fitness += compute_fitness.evaluate_rpc(*individual.genome, ant_id);
-
-                    // 7. Afficher la fitness de l'individu pour ce round
-                    std::cout << "Fitness de l'individu " << ant_id << " : " << individual.fitness << std::endl;
-                    
+                    fitness += rpc_scores[index];
 
+                    // 7. Noter la fitness de l'individu pour ce round
+                    trace.emplace_back(ant_id, fitness);
                 }
             }
+            return fitness;
+        }, num_threads);
+
+        // Affichage des fitness par round, dans l'ordre des individus (les individus dont la fitness
+        // était en cache n'ont pas été simulés)
+        for (const auto &trace : round_fitness) {
+            for (const auto &[ant_id, fitness] : trace) {
+                std::cout << "Fitness de l'individu " << ant_id << " : " << fitness << std::endl;
+            }
+        }
+        population.get_fitness_cache().get_stats().print(std::cout);
+
+        // Statistiques des caches de réseaux pour cette génération (tous threads confondus)
+        std::size_t cache_hits = 0, cache_patches = 0, cache_misses = 0;
+        for (const auto &worker : fitness_workers) {
+            const NetworkCache &network_cache = worker.get_network_cache();
+            cache_hits += network_cache.hits();
+            cache_patches += network_cache.patches();
+            cache_misses += network_cache.misses();
         }
+        std::cout << "Cache de réseaux : " << cache_hits << " succès, "
+                  << cache_patches << " corrigés, "
+                  << cache_misses << " compilés" << std::endl;
 
         // Sauvegarde des génomes pour suivi
         int individual_index = 0;
         for (const auto &individual : population.get_individuals()) {
-            save(*individual.genome, "genome_saves/genome_generation_" 
-                                     + std::to_string(generation) 
-                                     + "_individual_" 
-                                     + std::to_string(individual_index++) + ".txt");
+            genome_writer.save(population.keep_alive(individual), "genome_saves/genome_generation_" 
+                                                  + std::to_string(generation) 
+                                                  + "_individual_" 
+                                                  + std::to_string(individual_index++) + ".txt");
         }
 
         // Mise à jour du meilleur individu
@@ -87,19 +139,31 @@ int main() {
 
         // Génération de la nouvelle population
         auto new_generation = population.reproduce();
+        population.get_speciation().get_stats().print(std::cout);
+        population.get_pipeline_stats().print(std::cout);
+        genome_writer.get_stats().print(std::cout);
+        genome_writer.reset_stats();
         if (new_generation.empty()) {
             throw std::runtime_error("Erreur : La génération produite est vide !");
         }
 
         population.replace_population(std::move(new_generation));
+        population.get_arena_stats().print(std::cout);
+
+        // Les réseaux des génomes de l'ancienne génération ne serviront plus
+        for (auto &worker : fitness_workers) {
+            worker.get_network_cache().retain(population.get_individuals());
+            worker.get_network_cache().reset_counters();
+        }
 
         // Affiche la meilleure fitness de la génération
         std::cout << "Meilleure fitness de la génération : " 
                   << population.get_individuals().front().fitness << std::endl;
 
         // Sauvegarde du meilleur génome
-        save(*population.get_individuals().front().genome, "best_genome_generation_" + std::to_string(generation + 1) + ".txt");
+        genome_writer.save(population.keep_alive(population.get_individuals().front()), "best_genome_generation_" + std::to_string(generation + 1) + ".txt");
     }
+    genome_writer.flush();
 
     
 
@@ -3,6 +3,7 @@
 #include "NeuralNetwork.h"
 #include "Utils.h"
 #include "NeatConfig.h"
+#include "GenomeWriter.h"
 #include <iostream>
 #include <vector>
 #include <numeric>  // Pour std::accumulate
@@ -12,6 +13,7 @@
 int main() {
     RNG rng;
     NeatConfig config;
+    config.fitness_cache_capacity = 4096; // Partie déterministe : la fitness ne dépend que du génome
     Population population(config, rng);
 
     // Conteneur pour la fitness moyenne par génération
@@ -37,8 +39,16 @@ int main() {
         }
     }
 
-    // Créer l'objet de calcul de fitness
-    ComputeFitness compute_fitness(rng);
+    // Un objet de calcul de fitness (et donc un cache de réseaux) par thread d'évaluation
+    // Leurs flux sont découpés d'un flux dédié (RNG::split) : ils ne reproduisent pas le flux de la
+    // population, et le nombre de threads n'influe pas sur celui-ci
+    const std::size_t num_threads = ThreadPool::resolve_size(config.num_threads);
+    RNG fitness_rng = rng.split();
+    std::vector<ComputeFitness> fitness_workers;
+    for (std::size_t worker = 0; worker < num_threads; ++worker) {
+        fitness_workers.emplace_back(fitness_rng);
+    }
+    ComputeFitness &compute_fitness = fitness_workers.front();
 
     const int num_generations = 10;
     const int num_rounds = 10;  // Nombre de rounds pour chaque simulation
@@ -46,36 +56,53 @@ int main() {
 
   
 
+    // Les génomes sont sauvegardés en arrière-plan, pendant que l'évolution continue
+    GenomeWriter genome_writer;
+
     for (int generation = 0; generation < num_generations; ++generation) {
         std::cout << "Génération " << generation + 1 << " : " << std::endl;
 
-        // Initialisation des fitness
-        for (auto &individual : population.get_individuals()) {
-            individual.fitness = 0.0;
-        }
+        // Score pierre-papier-ciseaux de chaque individu, calculé une seule fois par topologie
+        GroupedEvaluator rpc_evaluator = compute_fitness.make_rpc_evaluator();
+        std::vector<double> rpc_scores = rpc_evaluator.evaluate(population.get_individuals(), /* measure_speedup */ true);
+        rpc_evaluator.get_stats().print(std::cout);
 
-        // Simulation pour chaque individu
-        for (int ant_id = 0; ant_id < num_ants; ++ant_id) {
-            for (auto &individual : population.get_individuals()) {
-                // 1. Créer un réseau neuronal pour cet individu
-                FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(*individual.genome);
+        // Simulation de chaque individu, en parallèle : chaque thread utilise son propre objet de
+        // calcul de fitness, et chaque individu son propre flux aléatoire
+        population.evaluate([&](std::size_t index, RNG &individual_rng, std::size_t worker) {
+            const Genome &genome = *population.get_individuals()[index].genome;
 
-                // 2. Simuler les rounds de pierre-papier-ciseaux
+            // 1. Récupérer le réseau neuronal de cet individu (compilé une seule fois par génome)
+            FeedForwardNeuralNetwork &network = fitness_workers[worker].get_network_cache().get(genome);
+            const std::size_t num_actions = network.num_outputs();
+
+            double fitness = 0.0;
+            for (int ant_id = 0; ant_id < num_ants; ++ant_id) {
+                // 2. Obtenir les états de jeu de tous les rounds (choix aléatoires de l'adversaire)
+                std::vector<double> game_states;
                 for (int round = 0; round < num_rounds; ++round) {
-                    // 3. Obtenir l'état de jeu (choix aléatoire de l'adversaire)
-                    std::vector<double> game_state = get_game_state_rpc(ant_id, rng);
+                    std::vector<double> game_state = get_game_state_rpc(ant_id, individual_rng);
+                    game_states.insert(game_states.end(), game_state.begin(), game_state.end());
+                }
+
+                // 3. Activer le réseau sur tous les rounds en un seul passage (choix de l'individu)
+                std::vector<double> all_actions = network.activate_batch(game_states, num_rounds);
 
-                    // 4. Activer le réseau avec l'état de jeu (choix de l'individu)
-                    std::vector<double> actions = network.activate(game_state);
+                // 4. Simuler les rounds de pierre-papier-ciseaux
+                for (int round = 0; round < num_rounds; ++round) {
+                    std::vector<double> actions(all_actions.begin() + round * num_actions,
+                                                all_actions.begin() + (round + 1) * num_actions);
 
                     // 5. Exécuter l'action du réseau
                     perform_action_rpc(actions, ant_id);
 
                     // 6. Évaluer la fitness de l'individu pour ce round
-                    individual.fitness += compute_fitness.evaluate_rpc(*individual.genome, ant_id);
+                    fitness += rpc_scores[index];
                 }
             }
-        }
+            return fitness;
+        }, num_threads);
+        population.get_fitness_cache().get_stats().print(std::cout);
 
         // Calcul de la fitness moyenne
         double total_fitness = 0.0;
@@ -89,13 +116,25 @@ int main() {
 
      
 
+        // Statistiques des caches de réseaux pour cette génération (tous threads confondus)
+        std::size_t cache_hits = 0, cache_patches = 0, cache_misses = 0;
+        for (const auto &worker : fitness_workers) {
+            const NetworkCache &network_cache = worker.get_network_cache();
+            cache_hits += network_cache.hits();
+            cache_patches += network_cache.patches();
+            cache_misses += network_cache.misses();
+        }
+        std::cout << "Cache de réseaux : " << cache_hits << " succès, "
+                  << cache_patches << " corrigés, "
+                  << cache_misses << " compilés" << std::endl;
+
         // Sauvegarde des génomes pour suivi
         int individual_index = 0;
         for (const auto &individual : population.get_individuals()) {
-            save(*individual.genome, "genome_saves/genome_generation_" 
-                                     + std::to_string(generation) 
-                                     + "_individual_" 
-                                     + std::to_string(individual_index++) + ".txt");
+            genome_writer.save(population.keep_alive(individual), "genome_saves/genome_generation_" 
+                                                  + std::to_string(generation) 
+                                                  + "_individual_" 
+                                                  + std::to_string(individual_index++) + ".txt");
         }
 
         // Mise à jour du meilleur individu
@@ -103,19 +142,31 @@ int main() {
 
         // Génération de la nouvelle population
         auto new_generation = population.reproduce();
+        population.get_speciation().get_stats().print(std::cout);
+        population.get_pipeline_stats().print(std::cout);
+        genome_writer.get_stats().print(std::cout);
+        genome_writer.reset_stats();
         if (new_generation.empty()) {
             throw std::runtime_error("Erreur : La génération produite est vide !");
         }
 
         population.replace_population(std::move(new_generation));
+        population.get_arena_stats().print(std::cout);
+
+        // Les réseaux des génomes de l'ancienne génération ne serviront plus
+        for (auto &worker : fitness_workers) {
+            worker.get_network_cache().retain(population.get_individuals());
+            worker.get_network_cache().reset_counters();
+        }
 
         // Affiche la meilleure fitness de la génération
         std::cout << "Meilleure fitness de la génération : " 
                   << population.get_individuals().front().fitness << std::endl;
 
         // Sauvegarde du meilleur génome
-        save(*population.get_individuals().front().genome, "best_genome_generation_" + std::to_string(generation + 1) + ".txt");
+        genome_writer.save(population.keep_alive(population.get_individuals().front()), "best_genome_generation_" + std::to_string(generation + 1) + ".txt");
     }
+    genome_writer.flush();
 
     // Exporter les données de fitness moyenne dans un fichier CSV
     std::ofstream file("fitness_moyenne.csv");
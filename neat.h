@@ -10,6 +10,10 @@
 #include "GenomeIndexer.h"
 #include "NeatConfig.h"
 #include <memory>
+#include <memory_resource>
+#include <cstdint>
+#include <limits>
+#include "rng.h"
 
 class Genome;
 
@@ -21,6 +25,8 @@ namespace neat
     
 
     // Structure d'un neurone dans le génome
+    // Les identifiants de neurones sont attribués pour toute la population (voir InnovationTracker) :
+    // l'identifiant sert donc aussi de numéro d'innovation au neurone.
     struct NeuronGene
     {
         int neuron_id;
@@ -61,6 +67,7 @@ namespace neat
         LinkId link_id;  // Connexion entre les neurones
         double weight;   // Poids de la connexion
         bool is_enabled; // Si la connexion est active
+        int innovation = -1; // Numéro d'innovation, partagé par toute la population
 
         // Définir l'opérateur == pour comparer deux LinkGene
         bool operator==(const LinkGene &other) const
@@ -74,20 +81,96 @@ namespace neat
         }
     };
 
+    // Indice d'un génome dans le pool de la population (voir GenomePool)
+    using GenomeHandle = std::uint32_t;
+    constexpr GenomeHandle no_genome_handle = std::numeric_limits<GenomeHandle>::max();
+
     // Structure pour représenter un individu
     struct Individual
 {
-    std::shared_ptr<Genome> genome;  // Utilise std::shared_ptr pour gérer le cycle de vie
+    std::shared_ptr<Genome> genome;  // Utilise std::shared_ptr pour gérer le cycle de vie (sans propriété pour un génome du pool)
     bool fitness_computed;
     double fitness;
+    GenomeHandle handle;             // Indice du génome dans le pool, no_genome_handle hors du pool
 
     Individual()
-        : genome(nullptr), fitness_computed(false), fitness(0.0) {}
+        : genome(nullptr), fitness_computed(false), fitness(0.0), handle(no_genome_handle) {}
 
-    Individual(std::shared_ptr<Genome> genome)
-        : genome(std::move(genome)), fitness_computed(false), fitness(0.0) {}
+    Individual(std::shared_ptr<Genome> genome, GenomeHandle handle = no_genome_handle)
+        : genome(std::move(genome)), fitness_computed(false), fitness(0.0), handle(handle) {}
 };
 
+    // Classement d'un gène lors de l'alignement de deux génomes
+    enum class GeneAlignment
+    {
+        Matching, // Présent chez les deux parents
+        Disjoint, // Présent chez un seul parent, à l'intérieur de la plage de l'autre
+        Excess    // Présent chez un seul parent, au-delà de la plage de l'autre
+    };
+
+    // Clé d'alignement d'un gène : identifiant pour les neurones, innovation pour les liens
+    inline int gene_key(const NeuronGene &neuron) { return neuron.neuron_id; }
+    inline int gene_key(const LinkGene &link) { return link.innovation; }
+
+    // Clé, poids et biais du gène d'indice i ; GeneColumns.h les surcharge pour lire directement les colonnes
+    template <typename Genes>
+    int gene_key(const Genes &genes, std::size_t i) { return gene_key(genes[i]); }
+    template <typename Genes>
+    double link_weight(const Genes &links, std::size_t i) { return links[i].weight; }
+    template <typename Genes>
+    double neuron_bias(const Genes &neurons, std::size_t i) { return neurons[i].bias; }
+
+    /**
+     * @brief Aligne les gènes de deux génomes en une seule passe de fusion.
+     *
+     * Les deux séquences doivent être triées par clé croissante (voir `gene_key`), ce que garantit Genome.
+     * Pour chaque gène rencontré, `visit(alignment, a, b)` est appelé avec des pointeurs vers le gène de
+     * chaque parent ; l'un des deux est nul pour un gène disjoint ou en excès. Avec la disposition en
+     * colonnes (voir GeneColumns.h), les pointeurs désignent des copies valables le temps de l'appel.
+     *
+     * @param a Les gènes du premier parent.
+     * @param b Les gènes du second parent.
+     * @param visit L'action à appliquer à chaque gène aligné.
+     */
+    template <typename Genes, typename Visitor>
+    void align_genes(const Genes &a, const Genes &b, Visitor &&visit)
+    {
+        using Gene = typename Genes::value_type;
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < a.size() && j < b.size())
+        {
+            int key_a = gene_key(a, i);
+            int key_b = gene_key(b, j);
+            if (key_a == key_b)
+            {
+                decltype(auto) gene_a = a[i++];
+                decltype(auto) gene_b = b[j++];
+                visit(GeneAlignment::Matching, &gene_a, &gene_b);
+            }
+            else if (key_a < key_b)
+            {
+                decltype(auto) gene_a = a[i++];
+                visit(GeneAlignment::Disjoint, &gene_a, static_cast<const Gene *>(nullptr));
+            }
+            else
+            {
+                decltype(auto) gene_b = b[j++];
+                visit(GeneAlignment::Disjoint, static_cast<const Gene *>(nullptr), &gene_b);
+            }
+        }
+        for (; i < a.size(); ++i)
+        {
+            decltype(auto) gene_a = a[i];
+            visit(GeneAlignment::Excess, &gene_a, static_cast<const Gene *>(nullptr));
+        }
+        for (; j < b.size(); ++j)
+        {
+            decltype(auto) gene_b = b[j];
+            visit(GeneAlignment::Excess, static_cast<const Gene *>(nullptr), &gene_b);
+        }
+    }
+
     struct DoubleConfig
     {
         double init_mean = 0.0;
@@ -103,6 +186,13 @@ namespace neat
     class Neat
     {
     public:
+        /**
+         * @brief Construit un objet Neat qui tire ses choix aléatoires du générateur fourni.
+         *
+         * @param rng Le générateur de nombres aléatoires ; il doit survivre à l'objet Neat.
+         */
+        explicit Neat(RNG &rng);
+
         /**
          * @brief Effectue un croisement entre deux objets NeuronGene.
          *
@@ -139,6 +229,7 @@ namespace neat
          * Cette fonction prend deux individus parents, un dominant et un récessif, et combine leurs génomes
          * pour produire un génome de descendance. La descendance hérite des neurones et des liens du parent dominant,
          * et, dans la mesure du possible, les combine avec des neurones correspondants et des liens provenant du parent récessif.
+         * Les gènes sont alignés par une seule passe de fusion sur les numéros d'innovation (voir `align_genes`).
          *
          * @param dominant Le parent dominant dont le génome contribuera principalement à la descendance.
          * @param recessive Le parent récessif dont le génome contribuera de façon secondaire à la descendance.
@@ -152,6 +243,11 @@ namespace neat
                        int child_genome_id);
 
     private:
+        RNG &rng;
+
+        // Fusion des gènes de deux génomes, commune à crossover et alt_crossover
+        Genome crossover_genomes(const Genome &dominant, const Genome &recessive, int child_genome_id);
+
         GenomeIndexer m_genome_indexer;
     };
 
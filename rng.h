@@ -4,11 +4,126 @@
 #include <random>
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
 
+/**
+ * @brief Générateur xoshiro256++ (Blackman et Vigna).
+ *
+ * Rapide, 256 bits d'état, période 2^256 - 1. Il satisfait UniformRandomBitGenerator et peut donc
+ * alimenter les distributions de <random>. Les flux indépendants sont obtenus par RNG::split.
+ */
+class Xoshiro256pp {
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256pp(std::uint64_t seed = 0) { reseed(seed); }
+
+    // Initialise les 256 bits d'état à partir d'une graine de 64 bits (splitmix64)
+    void reseed(std::uint64_t seed) {
+        for (auto &word : s) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
 
+    std::uint64_t s[4];
+};
+
+
+/**
+ * @brief Générateur de nombres aléatoires partagé par tout l'algorithme.
+ *
+ * Il est initialisé une seule fois (graine explicite, ou std::random_device par défaut) puis passé
+ * par référence aux fonctions qui en ont besoin. Une copie reprend l'état du générateur et répète donc
+ * ses tirages : seul `split()` fournit un flux indépendant pour un thread ou un génome, de sorte qu'un
+ * calcul parallèle reste reproductible à graine égale.
+ */
 class RNG {
 public:
-    RNG() : gen(rd()) {}  // Initialisation du générateur
+    RNG() : gen(std::random_device{}()) {}  // Graine non déterministe
+
+    explicit RNG(std::uint64_t seed) : gen(seed) {}  // Graine explicite : exécution reproductible
+
+    /**
+     * @brief Crée un flux indépendant de celui-ci.
+     *
+     * L'état du flux retourné est dérivé par splitmix64 d'un tirage de ce générateur, qui avance d'autant.
+     * Le flux ne reprend donc pas l'état courant : ni des découpages successifs, ni le découpage d'un
+     * flux déjà découpé ne reproduisent ce générateur ou un autre flux. Des sauts de 2^128 tirages
+     * n'offriraient pas cette garantie pour des découpages imbriqués. Le flux commence avec une réserve
+     * de normales vide.
+     */
+    RNG split() {
+        return RNG(gen());
+    }
+
+    /**
+     * @brief Remplit un tableau de réels uniformes dans [min, max).
+     *
+     * @param out Le tableau à remplir.
+     * @param n Le nombre de valeurs.
+     */
+    void fill_uniform(double *out, std::size_t n, double min = 0.0, double max = 1.0) {
+        const double scale = (max - min) * 0x1.0p-53;
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = min + static_cast<double>(gen() >> 11) * scale;
+        }
+    }
+
+    /**
+     * @brief Remplit un tableau de tirages gaussiens (méthode polaire de Marsaglia).
+     *
+     * Chaque paire de normales coûte un logarithme et une racine, sans sinus ni cosinus ; environ 21 %
+     * des paires d'uniformes sont rejetées. Box-Muller, dont les fonctions trigonométriques ne sont pas
+     * vectorisées sans bibliothèque mathématique vectorielle, est deux fois plus lent (bench/bench_rng.cpp).
+     *
+     * @param out Le tableau à remplir.
+     * @param n Le nombre de valeurs.
+     * @param mean La moyenne de la distribution.
+     * @param stddev L'écart-type de la distribution.
+     */
+    void fill_gaussian(double *out, std::size_t n, double mean = 0.0, double stddev = 1.0) {
+        for (std::size_t i = 0; i < n; i += 2) {
+            // Point uniforme du disque unité, hors origine
+            double u, v, s;
+            do {
+                u = 2.0 * next_double() - 1.0;
+                v = 2.0 * next_double() - 1.0;
+                s = u * u + v * v;
+            } while (s >= 1.0 || s == 0.0);
+
+            const double factor = std::sqrt(-2.0 * std::log(s) / s) * stddev;
+            out[i] = mean + u * factor;
+            if (i + 1 < n) {
+                out[i + 1] = mean + v * factor;  // Nombre impair : la dernière normale de la paire est perdue
+            }
+        }
+    }
 
     bool next_bool() {
         std::uniform_int_distribution<> dis(0, 1);  // Génère un entier 0 ou 1
@@ -28,9 +143,9 @@ public:
         return (dis(gen) < probability) ? a : b;     // Retourne a si la probabilité est respectée, sinon b
     }
 
-    // Méthode pour choisir un élément aléatoire dans un vecteur
-    template <typename T>
-    T choose_random(const std::vector<T>& vec) {
+    // Méthode pour choisir un élément aléatoire dans un vecteur (ou tout conteneur indexable)
+    template <typename Container>
+    typename Container::value_type choose_random(const Container& vec) {
         if (vec.empty()) {
             throw std::out_of_range("Cannot choose from an empty vector.");
         }
@@ -55,14 +170,22 @@ public:
         return *(std::begin(options) + dis(gen));  // Retourner un élément aléatoire
     }
 
+    // Tirage gaussien servi depuis un bloc de normales centrées réduites générées par `fill_gaussian`.
+    // Le bloc grandit avec l'usage (8, 16, ... 256 normales) : un flux qui ne tire que quelques normales
+    // n'en génère pas 256
     double next_gaussian(double mean, double stddev) {
-    std::normal_distribution<double> dist(mean, stddev);
-    return dist(gen);  // Utilise le générateur de nombres aléatoires défini dans RNG
-}
+        if (gaussian_pos == gaussian_pool.size()) {
+            gaussian_pool.resize(gaussian_block);
+            fill_gaussian(gaussian_pool.data(), gaussian_block);
+            gaussian_pos = 0;
+            gaussian_block = std::min(2 * gaussian_block, max_gaussian_block);
+        }
+        return mean + stddev * gaussian_pool[gaussian_pos++];
+    }
 
     double next_double() {
-        std::uniform_real_distribution<> dis(0, 1);  // Distribution pour les nombres réels entre 0 et 1
-        return dis(gen);  // Retourne un nombre aléatoire entre 0 et 1
+        // 53 bits de poids fort -> réel uniforme dans [0, 1)
+        return static_cast<double>(gen() >> 11) * 0x1.0p-53;
     }
 
 template <typename T>
@@ -79,8 +202,12 @@ T& choose_random(const std::vector<T>& vec, int limit) {
 
 
 private:
-    std::random_device rd;  // Source d'entropie pour la génération aléatoire
-    std::mt19937 gen;       // Générateur de nombres aléatoires basé sur Mersenne Twister
+    static constexpr std::size_t max_gaussian_block = 256;
+
+    Xoshiro256pp gen;  // Générateur de nombres aléatoires xoshiro256++
+    std::vector<double> gaussian_pool;  // Normales centrées réduites pré-tirées
+    std::size_t gaussian_pos = 0;       // Prochaine normale à servir
+    std::size_t gaussian_block = 8;     // Taille du prochain bloc
 };
 
 #endif // RNG_H
@@ -0,0 +1,46 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <cstdio>
+
+/**
+ * Vérifications minimales pour les tests de tests/.
+ *
+ * Chaque test est un exécutable autonome (voir la cible `test` du Makefile) : il appelle `check` pour
+ * chaque propriété vérifiée et retourne `report()` depuis main, qui vaut 1 si une vérification a échoué.
+ */
+namespace test
+{
+    inline int &checks()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    // Enregistre une vérification ; affiche `message` si elle échoue
+    inline bool check(bool condition, const char *message)
+    {
+        ++checks();
+        if (!condition)
+        {
+            ++failures();
+            std::printf("ÉCHEC : %s\n", message);
+        }
+        return condition;
+    }
+
+    // Affiche le bilan et retourne le code de sortie du test
+    inline int report(const char *name)
+    {
+        std::printf("%s : %d vérifications, %d échecs\n", name, checks(), failures());
+        return failures() == 0 ? 0 : 1;
+    }
+} // namespace test
+
+#endif // TEST_H
@@ -0,0 +1,85 @@
+// Précision des noyaux d'activation vectorisés par rapport aux foncteurs scalaires de ActivationFn.h
+#include "test.h"
+#include "ActivationKernels.h"
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // Écart maximal toléré : l'approximation de exp (Cephes) est précise à quelques ulp près
+    constexpr double tolerance = 1e-14;
+
+    // Compare `kernel` au foncteur scalaire `reference` sur `inputs`, découpés en tableaux de toutes les
+    // tailles de 1 à 9 pour passer par les boucles vectorielles et par les fins de tableau
+    template <typename Reference>
+    double max_error(void (*kernel)(double *, std::size_t), Reference reference, const std::vector<double> &inputs,
+                     const char *name)
+    {
+        double worst = 0.0;
+        for (std::size_t chunk = 1; chunk <= 9; ++chunk)
+        {
+            std::vector<double> values = inputs;
+            for (std::size_t start = 0; start < values.size(); start += chunk)
+            {
+                kernel(values.data() + start, std::min(chunk, values.size() - start));
+            }
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                const double expected = reference(inputs[i]);
+                if (std::isnan(expected))
+                {
+                    if (!std::isnan(values[i]))
+                    {
+                        std::printf("%s(%g) = %g au lieu de NaN\n", name, inputs[i], values[i]);
+                        test::check(false, "NaN conservé");
+                    }
+                    continue;
+                }
+                const double error = values[i] == expected ? 0.0 : std::fabs(values[i] - expected);  // Infinis égaux
+                if (!(error <= tolerance))
+                {
+                    std::printf("%s(%.17g) = %.17g au lieu de %.17g\n", name, inputs[i], values[i], expected);
+                }
+                worst = std::max(worst, error);
+            }
+        }
+        return worst;
+    }
+} // namespace
+
+int main()
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    // Balayage régulier, puis valeurs particulières (zéros signés, saturation de exp, infinis, NaN)
+    std::vector<double> inputs;
+    for (int i = -400000; i <= 400000; ++i)
+    {
+        inputs.push_back(i * 1e-4);
+    }
+    for (double value : {0.0, -0.0, 1e-300, -1e-300, 0.625, -0.625, 700.0, -700.0, 710.0, -710.0, 1e6, -1e6, inf, -inf, nan, -nan})
+    {
+        inputs.push_back(value);
+    }
+
+    std::printf("Noyaux : %s\n", activation_kernels_isa());
+
+    const double sigmoid_error = max_error(sigmoid_array, Sigmoid{}, inputs, "sigmoid");
+    const double tanh_error = max_error(tanh_array, Tanh{}, inputs, "tanh");
+    const double relu_error = max_error(relu_array, ReLU{}, inputs, "relu");
+    std::printf("Écart maximal : sigmoid %.3g, tanh %.3g, relu %.3g\n", sigmoid_error, tanh_error, relu_error);
+
+    test::check(sigmoid_error <= tolerance, "sigmoid_array proche de Sigmoid");
+    test::check(tanh_error <= tolerance, "tanh_array proche de Tanh");
+    test::check(relu_error == 0.0, "relu_array identique à ReLU");
+
+    // apply_activation résout le variant et appelle le même noyau
+    std::vector<double> values = {-2.0, -0.5, 0.0, 0.5, 2.0, nan};
+    apply_activation(ActivationFn{Tanh{}}, values.data(), values.size());
+    test::check(std::fabs(values[4] - std::tanh(2.0)) <= tolerance && std::isnan(values[5]), "apply_activation(Tanh)");
+
+    return test::report("test_activation_kernels");
+}
@@ -0,0 +1,136 @@
+// Reproductibilité : à graine égale, la population ne dépend pas du nombre de threads
+#include "test.h"
+#include "Population.h"
+#include "NeuralNetwork.h"
+#include <vector>
+
+namespace
+{
+    constexpr int generations = 15;
+
+    // Fitness tirée, comme dans main3, sur des entrées aléatoires : elle dépend aussi du flux de l'individu
+    double fitness(const Genome &genome, RNG &rng)
+    {
+        FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(genome);
+        std::vector<double> inputs(genome.get_num_inputs());
+        std::vector<double> outputs;
+        double total = 0.0;
+        for (int sample = 0; sample < 4; ++sample)
+        {
+            for (double &input : inputs)
+            {
+                input = rng.next_gaussian(0.0, 1.0);
+            }
+            network.activate(inputs, outputs);
+            for (double output : outputs)
+            {
+                total += output;
+            }
+        }
+        return total;
+    }
+
+    // Tous les gènes d'un génome, à la suite : identifiants, poids, biais et état des liens
+    std::vector<double> genes(const Genome &genome)
+    {
+        std::vector<double> values;
+        for (const auto &neuron : genome.get_neurons())
+        {
+            values.push_back(neuron.neuron_id);
+            values.push_back(neuron.bias);
+        }
+        for (const auto &link : genome.get_links())
+        {
+            values.push_back(link.link_id.input_id);
+            values.push_back(link.link_id.output_id);
+            values.push_back(link.weight);
+            values.push_back(link.is_enabled);
+        }
+        return values;
+    }
+
+    struct Snapshot
+    {
+        std::vector<std::vector<double>> genomes;
+        std::vector<double> fitness;
+
+        bool operator==(const Snapshot &other) const
+        {
+            return genomes == other.genomes && fitness == other.fitness;
+        }
+    };
+
+    Snapshot snapshot(Population &population)
+    {
+        Snapshot result;
+        for (const neat::Individual &individual : population.get_individuals())
+        {
+            result.genomes.push_back(genes(*individual.genome));
+            result.fitness.push_back(individual.fitness);
+        }
+        return result;
+    }
+
+    NeatConfig make_config(int num_threads)
+    {
+        NeatConfig config;
+        config.population_size = 200;
+        config.probability_add_link = 0.3;
+        config.probability_remove_link = 0.05;
+        config.probability_add_neuron = 0.1;
+        config.num_threads = num_threads;
+        return config;
+    }
+
+    // Évaluation puis reproduction, en deux étapes
+    Snapshot run_evaluate_reproduce(int num_threads)
+    {
+        RNG rng(42);
+        Population population(make_config(num_threads), rng);
+        for (int generation = 0; generation < generations; ++generation)
+        {
+            population.evaluate([&](std::size_t index, RNG &individual_rng, std::size_t)
+            {
+                return fitness(*population.get_individuals()[index].genome, individual_rng);
+            }, num_threads);
+            population.replace_population(population.reproduce());
+        }
+        population.evaluate([&](std::size_t index, RNG &individual_rng, std::size_t)
+        {
+            return fitness(*population.get_individuals()[index].genome, individual_rng);
+        }, num_threads);
+        return snapshot(population);
+    }
+
+    // Reproduction et évaluation en pipeline
+    Snapshot run_reproduce_and_evaluate(int num_threads)
+    {
+        RNG rng(42);
+        Population population(make_config(num_threads), rng);
+        population.evaluate([&](std::size_t index, RNG &individual_rng, std::size_t)
+        {
+            return fitness(*population.get_individuals()[index].genome, individual_rng);
+        }, num_threads);
+        for (int generation = 0; generation < generations; ++generation)
+        {
+            population.replace_population(population.reproduce_and_evaluate([](const Genome &genome, RNG &individual_rng, std::size_t)
+            {
+                return fitness(genome, individual_rng);
+            }, num_threads));
+        }
+        return snapshot(population);
+    }
+} // namespace
+
+int main()
+{
+    const Snapshot sequential = run_evaluate_reproduce(1);
+    test::check(sequential == run_evaluate_reproduce(1), "evaluate + reproduce : deux exécutions sur 1 thread");
+    test::check(sequential == run_evaluate_reproduce(4), "evaluate + reproduce : 1 thread contre 4");
+
+    const Snapshot pipelined = run_reproduce_and_evaluate(1);
+    test::check(pipelined == run_reproduce_and_evaluate(4), "reproduce_and_evaluate : 1 thread contre 4");
+    test::check(pipelined == run_reproduce_and_evaluate(3), "reproduce_and_evaluate : 1 thread contre 3");
+
+    return test::report("test_determinism");
+}
@@ -0,0 +1,166 @@
+// Les accesseurs de gènes et les mutations de paramètres ne doivent pas copier les gènes du génome
+#include "test.h"
+#include "Mutator.h"
+#include "NeuralNetwork.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace
+{
+    // Compteur d'allocations : nombre d'appels à operator new, plus grand bloc demandé, et nombre de blocs
+    // de taille `watched_size`
+    std::size_t allocations = 0;
+    std::size_t largest_block = 0;
+    std::size_t watched_size = 0;
+    std::size_t watched_allocations = 0;
+} // namespace
+
+namespace
+{
+    void *counted_allocation(std::size_t size, std::size_t alignment)
+    {
+        ++allocations;
+        largest_block = std::max(largest_block, size);
+        if (size == watched_size)
+        {
+            ++watched_allocations;
+        }
+        // Les gènes n'ont pas d'alignement étendu : malloc suffit
+        void *block = alignment <= alignof(std::max_align_t) ? std::malloc(size == 0 ? 1 : size) : nullptr;
+        if (!block)
+        {
+            throw std::bad_alloc();
+        }
+        return block;
+    }
+} // namespace
+
+// Les conteneurs std::pmr passent par la forme alignée (std::pmr::new_delete_resource)
+void *operator new(std::size_t size)
+{
+    return counted_allocation(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *block) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void *block, std::size_t) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void *block, std::align_val_t) noexcept
+{
+    std::free(block);
+}
+
+void operator delete(void *block, std::size_t, std::align_val_t) noexcept
+{
+    std::free(block);
+}
+
+namespace
+{
+    // Nombre d'allocations faites par `run`
+    template <typename Run>
+    std::size_t count_allocations(Run &&run)
+    {
+        const std::size_t before = allocations;
+        run();
+        return allocations - before;
+    }
+
+    // 4 entrées, 2 sorties, `num_hidden` neurones cachés reliés chacun à toutes les entrées et sorties
+    Genome make_genome(int num_hidden)
+    {
+        Genome genome(1, 4, 2);
+        for (int id = 0; id < 6 + num_hidden; ++id)
+        {
+            genome.add_neuron(neat::NeuronGene{id, 0.1 * id, Activation(Activation::Type::Sigmoid)});
+        }
+        int innovation = 0;
+        for (int hidden = 6; hidden < 6 + num_hidden; ++hidden)
+        {
+            for (int input = 0; input < 4; ++input)
+            {
+                genome.add_link(neat::LinkGene{neat::LinkId{input, hidden}, 0.5, true, innovation++});
+            }
+            for (int output = 4; output < 6; ++output)
+            {
+                genome.add_link(neat::LinkGene{neat::LinkId{hidden, output}, -0.5, true, innovation++});
+            }
+        }
+        return genome;
+    }
+} // namespace
+
+int main()
+{
+    Genome genome = make_genome(97);
+    const Genome &view = genome;
+
+    // Accesseurs et recherches : aucune allocation
+    std::size_t enabled = 0;
+    test::check(count_allocations([&]
+    {
+        for (const auto &link : view.get_links())
+        {
+            enabled += link.is_enabled;
+        }
+        for (const auto &neuron : view.get_neurons())
+        {
+            enabled += view.find_neuron(neuron.neuron_id).has_value();
+        }
+        enabled += view.find_link(neat::LinkId{0, 6}).has_value();
+    }) == 0, "get_links, get_neurons, find_neuron et find_link sans allocation");
+    test::check(enabled == view.get_links().size() + view.get_neurons().size() + 1, "gènes parcourus");
+
+    // Mutations de poids et de biais : aucune allocation une fois les tampons du générateur et du génome remplis
+    NeatConfig config;
+    RNG rng(10);
+    auto mutate_parameters = [&]
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            Mutator::mutate_link_weight(genome, config, rng);
+            Mutator::mutate_neuron_bias(genome, config, rng);
+        }
+    };
+    mutate_parameters();
+    test::check(count_allocations(mutate_parameters) == 0, "mutate_link_weight et mutate_neuron_bias sans allocation");
+
+    // Compilation d'un réseau : aucun bloc de la taille d'une copie du tableau des liens. Avec
+    // NEAT_SOA_GENOMES ou NEAT_COMPACT_GENES, les colonnes ont la taille des tableaux de travail du calcul
+    // des couches : la taille ne suffit plus à reconnaître une copie
+#if !defined(NEAT_SOA_GENOMES) && !defined(NEAT_COMPACT_GENES)
+    {
+        largest_block = 0;
+        neat::LinkGenes copy = view.get_links();
+        watched_size = largest_block;
+        test::check(watched_size >= copy.size() * sizeof(neat::LinkGene), "taille d'une copie des liens");
+    }
+    watched_allocations = 0;
+#endif
+    FeedForwardNeuralNetwork network = FeedForwardNeuralNetwork::create_from_genome(view);
+#if !defined(NEAT_SOA_GENOMES) && !defined(NEAT_COMPACT_GENES)
+    test::check(watched_allocations == 0, "create_from_genome ne copie pas les liens");
+    watched_size = 0;
+#endif
+
+    std::vector<double> outputs;
+    network.activate({0.1, 0.2, 0.3, 0.4}, outputs);
+    test::check(outputs.size() == 2, "réseau compilé");
+
+    return test::report("test_genome_copies");
+}
@@ -0,0 +1,95 @@
+// Correction en place des réseaux du cache : elle doit donner le même réseau qu'une compilation complète
+#include "test.h"
+#include "NetworkCache.h"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+    // 3 entrées, 2 sorties, 4 neurones cachés en deux couches
+    Genome make_genome(RNG &rng)
+    {
+        Genome genome(7, 3, 2);
+        for (int id = 0; id < 9; ++id)
+        {
+            genome.add_neuron(neat::NeuronGene{id, rng.next_gaussian(0.0, 1.0), Activation(Activation::Type::Sigmoid)});
+        }
+        const neat::LinkId link_ids[] = {{0, 5}, {1, 5}, {1, 6}, {2, 6}, {5, 7}, {6, 7}, {5, 8}, {6, 8},
+                                         {7, 3}, {8, 3}, {7, 4}, {8, 4}, {0, 4}};
+        int innovation = 0;
+        for (const neat::LinkId &link_id : link_ids)
+        {
+            genome.add_link(neat::LinkGene{link_id, rng.next_gaussian(0.0, 1.0), true, innovation++});
+        }
+        return genome;
+    }
+
+    // Le réseau du cache donne-t-il les sorties d'un réseau compilé depuis le génome ?
+    bool same_as_compiled(FeedForwardNeuralNetwork &cached, const Genome &genome)
+    {
+        FeedForwardNeuralNetwork compiled = FeedForwardNeuralNetwork::create_from_genome(genome);
+        const std::vector<double> inputs = {0.3, -1.2, 0.7};
+        std::vector<double> expected;
+        std::vector<double> outputs;
+        compiled.activate(inputs, expected);
+        cached.activate(inputs, outputs);
+        for (std::size_t o = 0; o < expected.size(); ++o)
+        {
+            if (outputs[o] != expected[o])
+            {
+                return false;
+            }
+        }
+        return !expected.empty();
+    }
+
+    std::size_t count_changes(const Genome &genome, unsigned long since)
+    {
+        std::size_t count = 0;
+        genome.for_each_parameter_change(since, [&](const Genome::ParameterChange &) { ++count; });
+        return count;
+    }
+} // namespace
+
+int main()
+{
+    RNG rng(3);
+    Genome genome = make_genome(rng);
+    const Genome &view = genome;
+    NetworkCache cache;
+
+    test::check(same_as_compiled(cache.get(genome), genome), "première compilation");
+    test::check(cache.misses() == 1, "génome inconnu compilé");
+
+    // Quelques poids et biais modifiés : seuls ces gènes sont rejoués
+    unsigned long version = genome.get_parameter_version();
+    genome.set_link_weight(2, 1.5);
+    genome.set_link_weight(10, -0.75);
+    genome.set_neuron_bias(6, 0.25);
+    test::check(count_changes(genome, version) == 3, "modifications connues du génome");
+    test::check(same_as_compiled(cache.get(genome), genome), "correction des gènes modifiés");
+    test::check(cache.patches() == 1 && cache.misses() == 1, "corrigé sans recompilation");
+    test::check(same_as_compiled(cache.get(genome), genome) && cache.hits() == 1, "réseau à jour réutilisé");
+
+    // Plus de modifications que le génome n'en garde : tous les paramètres sont recopiés
+    version = genome.get_parameter_version();
+    for (std::size_t i = 0; i < Genome::max_parameter_changes + 5; ++i)
+    {
+        genome.set_link_weight(i % view.get_links().size(), rng.next_gaussian(0.0, 1.0));
+        genome.set_neuron_bias(i % view.get_neurons().size(), rng.next_gaussian(0.0, 1.0));
+    }
+    test::check(!genome.for_each_parameter_change(version, [](const Genome::ParameterChange &) {}), "journal dépassé");
+    test::check(same_as_compiled(cache.get(genome), genome), "rechargement complet");
+    test::check(cache.patches() == 2 && cache.misses() == 1, "rechargé sans recompilation");
+
+    // Un lien désactivé : les positions du journal ne valent plus, le réseau est recompilé
+    version = genome.get_parameter_version();
+    genome.set_link_enabled(neat::LinkId{0, 4}, false);
+    test::check(count_changes(genome, version) == 0, "journal vidé par la modification structurelle");
+    genome.set_link_weight(0, 2.0);
+    test::check(same_as_compiled(cache.get(genome), genome), "recompilation après modification structurelle");
+    test::check(cache.misses() == 2, "structure modifiée recompilée");
+
+    return test::report("test_network_cache");
+}
@@ -0,0 +1,115 @@
+// Générateur : flux découpés sans recouvrement et moments des tirages gaussiens
+#include "test.h"
+#include "rng.h"
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+namespace
+{
+    constexpr int draws = 1000;
+
+    std::vector<double> first_draws(RNG &rng)
+    {
+        std::vector<double> values;
+        for (int i = 0; i < draws; ++i)
+        {
+            values.push_back(rng.next_double());
+        }
+        return values;
+    }
+
+    // Un tirage commun à deux flux (53 bits aléatoires) trahit un recouvrement de leurs séquences
+    bool disjoint(const std::vector<std::vector<double>> &streams)
+    {
+        std::set<double> seen;
+        std::size_t total = 0;
+        for (const auto &stream : streams)
+        {
+            seen.insert(stream.begin(), stream.end());
+            total += stream.size();
+        }
+        return seen.size() == total;
+    }
+} // namespace
+
+int main()
+{
+    // Flux frères : découpages successifs d'un même générateur
+    {
+        RNG rng(12);
+        std::vector<RNG> siblings;
+        for (int i = 0; i < 8; ++i)
+        {
+            siblings.push_back(rng.split());
+        }
+        std::vector<std::vector<double>> streams;
+        for (RNG &sibling : siblings)
+        {
+            streams.push_back(first_draws(sibling));
+        }
+        streams.push_back(first_draws(rng));
+        test::check(disjoint(streams), "flux frères disjoints entre eux et du générateur");
+    }
+
+    // Flux imbriqués : comme mainrpc, qui découpe un flux d'évaluation que ComputeFitness découpe à son tour
+    {
+        RNG rng(12);
+        RNG fitness_rng = rng.split();
+        RNG worker = fitness_rng.split();
+        RNG nested = worker.split();
+        RNG next = rng.split();
+        RNG next_nested = next.split();
+        test::check(disjoint({first_draws(worker), first_draws(nested), first_draws(next), first_draws(next_nested),
+                              first_draws(fitness_rng), first_draws(rng)}),
+                    "flux imbriqués disjoints du générateur et des découpages suivants");
+    }
+
+    // Reproductibilité : même graine, mêmes flux
+    {
+        RNG a(7);
+        RNG b(7);
+        RNG a_child = a.split();
+        RNG b_child = b.split();
+        RNG a_nested = a_child.split();
+        RNG b_nested = b_child.split();
+        test::check(first_draws(a_nested) == first_draws(b_nested) && first_draws(a) == first_draws(b),
+                    "découpage déterministe à graine égale");
+    }
+
+    // Les normales déjà tirées par le générateur ne sont pas servies une seconde fois par un flux
+    {
+        RNG rng(3);
+        rng.next_gaussian(0.0, 1.0);
+        RNG stream = rng.split();
+        std::vector<double> parent_normals;
+        std::vector<double> stream_normals;
+        for (int i = 0; i < draws; ++i)
+        {
+            parent_normals.push_back(rng.next_gaussian(0.0, 1.0));
+            stream_normals.push_back(stream.next_gaussian(0.0, 1.0));
+        }
+        test::check(disjoint({parent_normals, stream_normals}), "réserve de normales propre à chaque flux");
+    }
+
+    // Moments des normales de fill_gaussian, sur un nombre impair de tirages
+    {
+        RNG rng(5);
+        std::vector<double> normals(100001);
+        rng.fill_gaussian(normals.data(), normals.size(), 2.0, 3.0);
+        double sum = 0.0;
+        double sum_squares = 0.0;
+        for (double value : normals)
+        {
+            sum += value;
+            sum_squares += value * value;
+        }
+        const double mean = sum / normals.size();
+        const double variance = sum_squares / normals.size() - mean * mean;
+        std::printf("fill_gaussian(2, 3) : moyenne %.4f, variance %.4f\n", mean, variance);
+        test::check(std::fabs(mean - 2.0) < 0.05 && std::fabs(variance - 9.0) < 0.2, "moyenne et variance de fill_gaussian");
+    }
+
+    return test::report("test_rng");
+}